@@ -0,0 +1,143 @@
+/**
+ * File    : CodeGenBench.cpp
+ * Author  : Emir Uner
+ * Summary : Measures code generation throughput in types per second.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Parser.hpp"
+#include "CodeGenPlan.hpp"
+#include "CommonHeaderGen.hpp"
+#include "TieHeaderGen.hpp"
+#include "Timer.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+using namespace xcomidl;
+
+namespace
+{
+
+/**
+ * Number of types declared by each group of makeIdl.
+ */
+int const typesPerGroup = 5;
+    
+/**
+ * An idl text with the given number of groups of related types,
+ * each group has an enum, a struct, a sequence, an exception and an
+ * interface so that every generator is exercised.
+ */
+std::string makeIdl(int groups)
+{
+    std::string result(
+        "namespace xcom\n"
+        "{\n"
+        "    interface IUnknown (\"00000000-0000-0000-0000-000000000000\") { }\n"
+        "}\n"
+        "\n"
+        "namespace bench\n"
+        "{\n"
+        );
+    char buffer[1024];
+    
+    for(int i = 0; i < groups; ++i)
+    {
+        sprintf(buffer,
+                "    enum Color%d { Red%d, Green%d, Blue%d }\n"
+                "    struct Point%d { int x; double y; string label; Color%d color; }\n"
+                "    sequence<Point%d> PointSeq%d;\n"
+                "    exception Error%d { string why; int code; }\n"
+                "    interface IShape%d (\"%08x-0000-4000-8000-000000000000\")\n"
+                "        extends xcom::IUnknown\n"
+                "    {\n"
+                "        Point%d at(in int index);\n"
+                "        void add(in PointSeq%d points, out int count);\n"
+                "        nothrow int size();\n"
+                "    }\n",
+                i, i, i, i, i, i, i, i, i, i, i + 1, i, i);
+        result += buffer;
+    }
+
+    result += "}\n";
+    
+    return result;
+}
+    
+} // namespace
+
+/**
+ * Usage: codegen_bench [groups [codegen options...]]
+ * Parses a generated idl of the given number of type groups, 1000 by
+ * default, and generates its headers with the given options.
+ */
+int main(int argc, char* argv[])
+{
+    int groups = argc > 1 ? atoi(argv[1]) : 1000;
+    xcom::StringSeq options;
+
+    for(int i = 2; i < argc; ++i)
+    {
+        options.push_back(argv[i]);
+    }
+    
+    try
+    {
+        std::string idl(makeIdl(groups));
+        xcom::StringSeq includes;
+        Repository repo;
+        Parser parser(includes, repo, 0);
+
+        Timer parseTimer;
+        HintSeq hints(parser.parseBuffer("bench.idl", idl));
+        double parseSeconds = parseTimer.seconds();
+
+        Timer genTimer;
+        Repository genRepo(repo.getTypes());
+        CodeGenPlan plan(genRepo, hints);
+        CodeGenOptions genOptions(options);
+        Fragments fragments;
+        std::string output;
+
+        renderFragments(plan, genOptions, fragments);
+        genCommonHeader(plan, genOptions, fragments, output);
+        genTieHeader(plan, fragments, output);
+        double genSeconds = genTimer.seconds();
+
+        int types = groups * typesPerGroup;
+        
+        printf("parse: %d types in %.3f s, %.0f types/s\n",
+               types, parseSeconds, types / parseSeconds);
+        printf("codegen: %d types in %.3f s, %.0f types/s, %.1f MB\n",
+               types, genSeconds, types / genSeconds,
+               double(output.size()) / (1 << 20));
+    }
+    catch(std::exception& e)
+    {
+        fprintf(stderr, "codegen: %s\n", e.what());
+        return 1;
+    }
+    
+    return 0;
+}
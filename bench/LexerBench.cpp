@@ -0,0 +1,284 @@
+/**
+ * File    : LexerBench.cpp
+ * Author  : Emir Uner
+ * Summary : Measures the lexer, mostly the keyword lookup.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Lexer.hpp"
+#include "SymbolTable.hpp"
+#include "Timer.hpp"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+using namespace xcomidl;
+
+namespace
+{
+
+/**
+ * A word of the source text.
+ */
+struct Word
+{
+    char const* str;
+    std::size_t length;
+};
+
+/**
+ * A keyword and its token type.
+ */
+struct Keyword
+{
+    char const* name;
+    TokenTypeEnum type;
+};
+
+Keyword const keywords[] =
+{
+    { "void", TokenType::Void },
+    { "namespace", TokenType::Namespace },
+    { "interface", TokenType::Interface },
+    { "array", TokenType::Array },
+    { "sequence", TokenType::Sequence },
+    { "struct", TokenType::Struct },
+    { "extends", TokenType::Extends },
+    { "boolean", TokenType::Bool },
+    { "octet", TokenType::Octet },
+    { "short", TokenType::Short },
+    { "int", TokenType::Int },
+    { "long", TokenType::Long },
+    { "char", TokenType::Char },
+    { "wchar", TokenType::WChar },
+    { "exception", TokenType::Exception },
+    { "float", TokenType::Float },
+    { "double", TokenType::Double },
+    { "in", TokenType::In },
+    { "out", TokenType::Out },
+    { "inout", TokenType::InOut },
+    { "string", TokenType::String },
+    { "wstring", TokenType::WString },
+    { "enum", TokenType::Enum },
+    { "import", TokenType::Import },
+    { "nothrow", TokenType::NoThrow },
+    { "any", TokenType::Any },
+    { "delegate", TokenType::Delegate }
+};
+
+/**
+ * Keyword classification as the lexer did it before the hash table:
+ * the identifier is copied into a string and compared with each
+ * keyword in turn.
+ */
+TokenTypeEnum compareKeywordType(std::string id)
+{
+    std::size_t const count = sizeof(keywords) / sizeof(keywords[0]);
+    
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        if(id == keywords[i].name)
+        {
+            return keywords[i].type;
+        }
+    }
+
+    return TokenType::Identifier;
+}
+
+/**
+ * Build an idl text of about the given size. Declarations repeat
+ * with new names, so that keywords and identifiers are both common.
+ */
+std::string makeSource(std::size_t size)
+{
+    std::string result;
+    char buffer[512];
+    int n = 0;
+
+    result.reserve(size + sizeof(buffer));
+    
+    while(result.size() < size)
+    {
+        sprintf(buffer,
+                "namespace bench%d\n"
+                "{\n"
+                "    struct Point%d\n"
+                "    {\n"
+                "        int x;\n"
+                "        double y;\n"
+                "        wstring label;\n"
+                "    };\n"
+                "\n"
+                "    interface IShape%d extends IUnknown\n"
+                "    {\n"
+                "        void move(in long dx, inout short dy);\n"
+                "        nothrow boolean contains(in Point%d p, out octet hit);\n"
+                "        sequence<Point%d> corners();\n"
+                "    };\n"
+                "}\n",
+                n, n, n, n, n);
+        result += buffer;
+        ++n;
+    }
+
+    return result;
+}
+
+/**
+ * The keywords and identifiers of the text.
+ */
+std::vector<Word> splitWords(std::string const& source)
+{
+    std::vector<Word> result;
+    char const* p = source.data();
+    char const* end = p + source.size();
+
+    while(p != end)
+    {
+        if(isalpha((unsigned char)*p) || *p == '_')
+        {
+            Word word;
+            word.str = p;
+            
+            while(p != end && (isalnum((unsigned char)*p) || *p == '_'))
+            {
+                ++p;
+            }
+
+            word.length = p - word.str;
+            result.push_back(word);
+        }
+        else
+        {
+            ++p;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Classify every word with the old string comparisons, return the
+ * number of keywords found.
+ */
+long classifyByCompare(std::vector<Word> const& words)
+{
+    long keywordCount = 0;
+    
+    for(std::vector<Word>::const_iterator i = words.begin();
+        i != words.end(); ++i)
+    {
+        if(compareKeywordType(std::string(i->str, i->length)) !=
+           TokenType::Identifier)
+        {
+            ++keywordCount;
+        }
+    }
+
+    return keywordCount;
+}
+
+/**
+ * Classify every word with the lexer's hash table, return the number
+ * of keywords found.
+ */
+long classifyByHash(std::vector<Word> const& words)
+{
+    long keywordCount = 0;
+    
+    for(std::vector<Word>::const_iterator i = words.begin();
+        i != words.end(); ++i)
+    {
+        if(Lexer::keywordType(i->str, i->length) != TokenType::Identifier)
+        {
+            ++keywordCount;
+        }
+    }
+
+    return keywordCount;
+}
+
+/**
+ * Lex the whole text, return the number of tokens read.
+ */
+long lexAll(std::string const& source, SymbolTable& symbols)
+{
+    Lexer lexer(source.data(), source.data() + source.size(),
+                "bench.idl", symbols);
+    long count = 0;
+
+    while(lexer.getNextToken().getType() != TokenType::Eof)
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+} // namespace
+
+/**
+ * Usage: lexer_bench [megabytes], the default input is 50 MB.
+ */
+int main(int argc, char* argv[])
+{
+    std::size_t megabytes = argc > 1 ? atoi(argv[1]) : 50;
+    std::string source = makeSource(megabytes << 20);
+    std::vector<Word> words = splitWords(source);
+
+    Timer compareTimer;
+    long compareKeywords = classifyByCompare(words);
+    double compareSeconds = compareTimer.seconds();
+
+    Timer hashTimer;
+    long hashKeywords = classifyByHash(words);
+    double hashSeconds = hashTimer.seconds();
+
+    if(compareKeywords != hashKeywords)
+    {
+        fprintf(stderr, "lexer: keyword counts differ, %ld and %ld\n",
+                compareKeywords, hashKeywords);
+        return 1;
+    }
+
+    printf("keywords: %lu words, %ld keywords\n",
+           (unsigned long)words.size(), hashKeywords);
+    printf("keywords: before %.1f ns/word, after %.1f ns/word, %.1fx\n",
+           compareSeconds * 1e9 / words.size(),
+           hashSeconds * 1e9 / words.size(),
+           compareSeconds / hashSeconds);
+
+    SymbolTable symbols;
+    Timer lexTimer;
+    long tokens = lexAll(source, symbols);
+    double lexSeconds = lexTimer.seconds();
+    
+    printf("lexer: %.1f MB, %ld tokens in %.3f s, %.0f tokens/s, %.1f MB/s\n",
+           double(source.size()) / (1 << 20), tokens, lexSeconds,
+           tokens / lexSeconds, double(source.size()) / (1 << 20) / lexSeconds);
+    
+    return 0;
+}
@@ -0,0 +1,175 @@
+/**
+ * File    : RegistryBench.cpp
+ * Author  : Emir Uner
+ * Summary : Measures registering the metadata of a large component.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <xcomidl/StaticMetadata.hpp>
+
+#include "Timer.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+/**
+ * Number of members of each struct, each refers to an earlier struct.
+ */
+int const memberCount = 3;
+
+/**
+ * Never called, the members refer to structs registered before.
+ */
+void noAddSelf(xcom::IUnknownSeq&)
+{
+}
+    
+/**
+ * Tables of typeCount structs as --static-metadata generates them,
+ * with name hashes if hashed is true.
+ */
+class Component
+{
+public:
+    Component(int typeCount, bool hashed)
+    : names_(typeCount), refs_(typeCount * memberCount),
+      tables_(typeCount)
+    {
+        char buffer[64];
+        
+        for(int i = 0; i < typeCount; ++i)
+        {
+            sprintf(buffer, "bench.module%d.Type%d", i % 100, i);
+            names_[i] = buffer;
+        }
+
+        for(int i = 0; i < typeCount; ++i)
+        {
+            int members[memberCount] = { i - 1, i / 2, i / 3 };
+            TypeRef* refs = &refs_[i * memberCount];
+
+            for(int m = 0; m < memberCount; ++m)
+            {
+                int member = members[m] < 0 ? 0 : members[m];
+
+                refs[m].name = names_[member].c_str();
+                refs[m].hash =
+                    hashed ? xcomidl::nameHash(refs[m].name) : 0;
+                refs[m].addSelf = &noAddSelf;
+            }
+
+            tables_[i].name = names_[i].c_str();
+            tables_[i].size = (int)(memberCount * sizeof(int));
+            tables_[i].memberCount = i == 0 ? 0 : memberCount;
+            tables_[i].types = refs;
+            tables_[i].names = memberNames;
+            tables_[i].offsets = memberOffsets;
+        }
+
+        hashed_ = hashed;
+    }
+
+    /**
+     * Register every struct as the addSelf of generated code does.
+     */
+    void registerAll(xcom::IUnknownSeq& types) const
+    {
+        for(std::size_t i = 0; i < tables_.size(); ++i)
+        {
+            char const* name = tables_[i].name;
+            bool exists = hashed_ ?
+                xcomidl::hashedTypeExists(types, name,
+                                          xcomidl::nameHash(name)) :
+                xcom::typeExists(types, name);
+            
+            if(!exists)
+            {
+                xcomidl::registerStruct(types, tables_[i]);
+            }
+        }
+    }
+    
+private:
+    typedef xcomidl::TypeRef TypeRef;
+
+    static xcom::Char const* const memberNames[memberCount];
+    static xcom::Int const memberOffsets[memberCount];
+    
+    std::vector<std::string> names_;
+    std::vector<TypeRef> refs_;
+    std::vector<xcomidl::StructTable> tables_;
+    bool hashed_;
+};
+
+xcom::Char const* const Component::memberNames[memberCount] =
+{
+    "a", "b", "c"
+};
+
+xcom::Int const Component::memberOffsets[memberCount] =
+{
+    0, sizeof(int), 2 * sizeof(int)
+};
+
+/**
+ * Register the component into an empty sequence and return the time.
+ */
+double run(Component const& component)
+{
+    xcom::IUnknownSeq types;
+    Timer timer;
+
+    component.registerAll(types);
+
+    return timer.seconds();
+}
+    
+} // namespace
+
+/**
+ * Usage: registry_bench [types]
+ * Registers the metadata of a component of the given number of
+ * structs, 5000 by default, by name and through the hashed registry.
+ */
+int main(int argc, char* argv[])
+{
+    int typeCount = argc > 1 ? atoi(argv[1]) : 5000;
+
+    if(typeCount < 1)
+    {
+        fprintf(stderr, "usage: registry_bench [types]\n");
+        return 1;
+    }
+    
+    double linear = run(Component(typeCount, false));
+    double hashed = run(Component(typeCount, true));
+
+    printf("registry: %d types, by name %.1f ms, hashed %.1f ms\n",
+           typeCount, linear * 1e3, hashed * 1e3);
+
+    return 0;
+}
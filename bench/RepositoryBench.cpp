@@ -0,0 +1,122 @@
+/**
+ * File    : RepositoryBench.cpp
+ * Author  : Emir Uner
+ * Summary : Measures Repository lookups as the type count grows.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <xcomidl/Repository.hpp>
+#include <xcom/metadata/Struct.hpp>
+
+#include "Timer.hpp"
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+using namespace xcomidl;
+using namespace xcom::metadata;
+
+namespace
+{
+
+/**
+ * Scoped name of the i'th benchmark type.
+ */
+std::string benchName(int i)
+{
+    char buffer[64];
+    sprintf(buffer, "bench.module%d.Type%d", i % 100, i);
+    return buffer;
+}
+
+/**
+ * Fill a repository with the given number of types and time
+ * the adds, the found lookups and the missed lookups.
+ */
+void run(int typeCount)
+{
+    long const lookups = 1000000;
+    std::vector<std::string> names;
+    std::vector<std::string> missing;
+
+    for(int i = 0; i < typeCount; ++i)
+    {
+        names.push_back(benchName(i));
+        missing.push_back(benchName(i + typeCount));
+    }
+
+    Repository repo;
+    Timer addTimer;
+    
+    for(int i = 0; i < typeCount; ++i)
+    {
+        repo.addType(new Struct(names[i].c_str(), -1));
+    }
+
+    double addSeconds = addTimer.seconds();
+    long found = 0;
+    Timer hitTimer;
+
+    for(long i = 0; i < lookups; ++i)
+    {
+        if(!repo.findType(names[i % typeCount]).isNil())
+        {
+            ++found;
+        }
+    }
+
+    double hitSeconds = hitTimer.seconds();
+    Timer missTimer;
+
+    for(long i = 0; i < lookups; ++i)
+    {
+        if(!repo.findType(missing[i % typeCount]).isNil())
+        {
+            ++found;
+        }
+    }
+
+    double missSeconds = missTimer.seconds();
+
+    if(found != lookups)
+    {
+        fprintf(stderr, "repository: %ld of %ld lookups found\n",
+                found, lookups);
+    }
+    
+    printf("repository: %6d types, add %.1f ns, hit %.1f ns, miss %.1f ns\n",
+           typeCount, addSeconds * 1e9 / typeCount,
+           hitSeconds * 1e9 / lookups, missSeconds * 1e9 / lookups);
+}
+
+} // namespace
+
+int main()
+{
+    for(int typeCount = 100; typeCount <= 100000; typeCount *= 10)
+    {
+        run(typeCount);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * File    : Timer.hpp
+ * Author  : Emir Uner
+ * Summary : Wall clock timer shared by the benchmarks.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_BENCH_TIMER_HPP_INCLUDED
+#define XCOMIDL_BENCH_TIMER_HPP_INCLUDED
+
+#include <chrono>
+
+/**
+ * Measures the wall clock time elapsed since construction.
+ */
+class Timer
+{
+public:
+    Timer()
+    : start_(std::chrono::steady_clock::now())
+    {
+    }
+
+    /**
+     * Seconds passed since the timer was constructed.
+     */
+    double seconds() const
+    {
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start_;
+
+        return elapsed.count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+};
+
+#endif
@@ -0,0 +1,71 @@
+/**
+ * File    : Hash.hpp
+ * Author  : Emir Uner
+ * Summary : FNV-1a hashes of names and file contents.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef XCOMIDL_HASH_HPP_INCLUDED
+#define XCOMIDL_HASH_HPP_INCLUDED
+
+namespace xcomidl
+{
+
+/**
+ * 32 bit FNV-1a hash of a type name. Code generated with the
+ * --hashed-registry option passes the hashes of the names it refers to,
+ * computed by this function at generation time.
+ */
+inline unsigned int nameHash(char const* name)
+{
+    unsigned int hash = 2166136261u;
+
+    while(*name != 0)
+    {
+        hash ^= (unsigned char)*name++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * 64 bit FNV-1a hash of the characters in [begin, end). Used wherever
+ * the contents of a file or a generated text are compared by hash.
+ */
+inline unsigned long long contentHash(char const* begin, char const* end)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+
+    while(begin != end)
+    {
+        hash ^= (unsigned char)*begin++;
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+} // namespace xcomidl
+
+#endif
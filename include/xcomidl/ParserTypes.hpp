@@ -15,6 +15,7 @@ namespace xcomidl
             GenForward,
             EnterNamespace,
             LeaveNamespace,
+            NoThrow,
             
         };
     }
@@ -88,6 +89,55 @@ namespace xcomidl
         }
     };
     
+    struct IImportResolverRaw : public xcom::IUnknownRaw
+    {
+    };
+    struct IImportResolverVtbl
+    {
+        xcom::IUnknownRaw* (*queryInterface)(void*, xcom::Environment*, xcom::GUID const* iid);
+        xcom::GUID (*getInterfaceId)(void*, xcom::Environment*);
+        xcom::Int (*addRef)(void*, xcom::Environment*);
+        xcom::Int (*release)(void*, xcom::Environment*);
+        xcom::Bool (*resolve)(void*, xcom::Environment*, const xcom::Char* name, xcom::Char** path, xcom::Char** contents);
+        
+    };
+    template<typename Impl> class IImportResolverTie;
+    class IImportResolver : public xcom::IUnknown
+    {
+    public:
+        typedef IImportResolverRaw* RawType;
+        typedef xcom::IUnknown ParentClass;
+        template<typename T>
+        struct Tie { typedef IImportResolverTie<T> type; };
+        IImportResolver() {}
+        IImportResolver(IImportResolverRaw* ptr) : xcom::IUnknown((xcom::IUnknownRaw*)ptr) {}
+        xcom::Bool resolve(const xcom::Char* name, xcom::String& path, xcom::String& contents) const;
+        
+        static IImportResolver adopt(IImportResolverRaw* src)
+        {
+            return IImportResolver(src);
+        }
+        
+        IImportResolverRaw* detach()
+        {
+            IImportResolverRaw* result = (IImportResolverRaw*)ptr_;
+            ptr_ = 0;
+            return result;
+        }
+        
+        static inline xcom::GUID const& thisInterfaceId()
+        {
+            static const xcom::GUID id =
+            {
+                711612053, -25385, 18004,
+                {0xb2, 0x82, 0x14, 0xa7, 0xe5, 0xac, 0xfc, 0xdb}
+            };
+            
+            return id;
+        }
+        
+    };
+    
     struct IParserRaw : public xcom::IUnknownRaw
     {
     };
@@ -137,6 +187,60 @@ namespace xcomidl
         
     };
     
+    struct IParser2Raw : public xcomidl::IParserRaw
+    {
+    };
+    struct IParser2Vtbl
+    {
+        xcom::IUnknownRaw* (*queryInterface)(void*, xcom::Environment*, xcom::GUID const* iid);
+        xcom::GUID (*getInterfaceId)(void*, xcom::Environment*);
+        xcom::Int (*addRef)(void*, xcom::Environment*);
+        xcom::Int (*release)(void*, xcom::Environment*);
+        xcom::Bool (*parse)(void*, xcom::Environment*, xcom::StringSeq::RawType const* includePaths, const xcom::Char* idlFile, xcomidl::TypeSeq::RawType* types, xcomidl::HintSeq::RawType* hints, xcom::StringSeq::RawType* messages);
+        xcom::Bool (*parseWithDependencies)(void*, xcom::Environment*, xcom::StringSeq::RawType const* includePaths, const xcom::Char* idlFile, xcomidl::TypeSeq::RawType* types, xcomidl::HintSeq::RawType* hints, xcom::StringSeq::RawType* dependencies, xcom::StringSeq::RawType* messages);
+        void (*setCacheDirectory)(void*, xcom::Environment*, const xcom::Char* directory);
+        xcom::Bool (*parseBuffer)(void*, xcom::Environment*, xcom::StringSeq::RawType const* includePaths, const xcom::Char* idlName, const xcom::Char* idlContents,  xcomidl::IImportResolverRaw* resolver, xcomidl::TypeSeq::RawType* types, xcomidl::HintSeq::RawType* hints, xcom::StringSeq::RawType* dependencies, xcom::StringSeq::RawType* messages);
+        
+    };
+    template<typename Impl> class IParser2Tie;
+    class IParser2 : public xcomidl::IParser
+    {
+    public:
+        typedef IParser2Raw* RawType;
+        typedef xcomidl::IParser ParentClass;
+        template<typename T>
+        struct Tie { typedef IParser2Tie<T> type; };
+        IParser2() {}
+        IParser2(IParser2Raw* ptr) : xcomidl::IParser((xcomidl::IParserRaw*)ptr) {}
+        xcom::Bool parseWithDependencies(xcom::StringSeq const& includePaths, const xcom::Char* idlFile, xcomidl::TypeSeq& types, xcomidl::HintSeq& hints, xcom::StringSeq& dependencies, xcom::StringSeq& messages) const;
+        void setCacheDirectory(const xcom::Char* directory) const;
+        xcom::Bool parseBuffer(xcom::StringSeq const& includePaths, const xcom::Char* idlName, const xcom::Char* idlContents, xcomidl::IImportResolver const& resolver, xcomidl::TypeSeq& types, xcomidl::HintSeq& hints, xcom::StringSeq& dependencies, xcom::StringSeq& messages) const;
+        
+        static IParser2 adopt(IParser2Raw* src)
+        {
+            return IParser2(src);
+        }
+        
+        IParser2Raw* detach()
+        {
+            IParser2Raw* result = (IParser2Raw*)ptr_;
+            ptr_ = 0;
+            return result;
+        }
+        
+        static inline xcom::GUID const& thisInterfaceId()
+        {
+            static const xcom::GUID id =
+            {
+                1742490768, -2174, 16556,
+                {0xb5, 0xd8, 0x0c, 0x83, 0x6e, 0xa0, 0xa0, 0x91}
+            };
+            
+            return id;
+        }
+        
+    };
+    
     struct ICodeGenRaw : public xcom::IUnknownRaw
     {
     };
@@ -186,9 +290,68 @@ namespace xcomidl
         
     };
     
+    struct ICodeGen2Raw : public xcomidl::ICodeGenRaw
+    {
+    };
+    struct ICodeGen2Vtbl
+    {
+        xcom::IUnknownRaw* (*queryInterface)(void*, xcom::Environment*, xcom::GUID const* iid);
+        xcom::GUID (*getInterfaceId)(void*, xcom::Environment*);
+        xcom::Int (*addRef)(void*, xcom::Environment*);
+        xcom::Int (*release)(void*, xcom::Environment*);
+        void (*generate)(void*, xcom::Environment*, xcomidl::TypeSeq::RawType const* types, xcomidl::HintSeq::RawType const* hints, const xcom::Char* idlFileName, xcom::StringSeq::RawType const* options);
+        void (*generateToBuffers)(void*, xcom::Environment*, xcomidl::TypeSeq::RawType const* types, xcomidl::HintSeq::RawType const* hints, const xcom::Char* idlFileName, xcom::StringSeq::RawType const* options, xcom::StringSeq::RawType* names, xcom::StringSeq::RawType* contents);
+        
+    };
+    template<typename Impl> class ICodeGen2Tie;
+    class ICodeGen2 : public xcomidl::ICodeGen
+    {
+    public:
+        typedef ICodeGen2Raw* RawType;
+        typedef xcomidl::ICodeGen ParentClass;
+        template<typename T>
+        struct Tie { typedef ICodeGen2Tie<T> type; };
+        ICodeGen2() {}
+        ICodeGen2(ICodeGen2Raw* ptr) : xcomidl::ICodeGen((xcomidl::ICodeGenRaw*)ptr) {}
+        void generateToBuffers(xcomidl::TypeSeq const& types, xcomidl::HintSeq const& hints, const xcom::Char* idlFileName, xcom::StringSeq const& options, xcom::StringSeq& names, xcom::StringSeq& contents) const;
+        
+        static ICodeGen2 adopt(ICodeGen2Raw* src)
+        {
+            return ICodeGen2(src);
+        }
+        
+        ICodeGen2Raw* detach()
+        {
+            ICodeGen2Raw* result = (ICodeGen2Raw*)ptr_;
+            ptr_ = 0;
+            return result;
+        }
+        
+        static inline xcom::GUID const& thisInterfaceId()
+        {
+            static const xcom::GUID id =
+            {
+                -843487814, 2769, 17564,
+                {0xab, 0x17, 0xf1, 0x71, 0x4c, 0x16, 0xcd, 0x6b}
+            };
+            
+            return id;
+        }
+        
+    };
+    
 }
 namespace xcomidl
 {
+    inline xcom::Bool IImportResolver::resolve(const xcom::Char* name, xcom::String& path, xcom::String& contents) const
+    {
+        xcom::Environment __exc_info;
+        xcom::Bool result(static_cast<IImportResolverVtbl*>(static_cast<IImportResolverRaw*>(ptr_)->vptr_)->resolve(ptr_, &__exc_info, name, (xcom::Char**)&path, (xcom::Char**)&contents));
+        if(__exc_info.exception) xcomFindAndThrow(&__exc_info);
+        
+        return result;
+    }
+    
     inline xcom::Bool IParser::parse(xcom::StringSeq const& includePaths, const xcom::Char* idlFile, xcomidl::TypeSeq& types, xcomidl::HintSeq& hints, xcom::StringSeq& messages) const
     {
         xcom::Environment __exc_info;
@@ -198,6 +361,32 @@ namespace xcomidl
         return result;
     }
     
+    inline xcom::Bool IParser2::parseWithDependencies(xcom::StringSeq const& includePaths, const xcom::Char* idlFile, xcomidl::TypeSeq& types, xcomidl::HintSeq& hints, xcom::StringSeq& dependencies, xcom::StringSeq& messages) const
+    {
+        xcom::Environment __exc_info;
+        xcom::Bool result(static_cast<IParser2Vtbl*>(static_cast<IParser2Raw*>(ptr_)->vptr_)->parseWithDependencies(ptr_, &__exc_info, (xcom::StringSeq::RawType const*)&includePaths, idlFile, (xcomidl::TypeSeq::RawType*)&types, (xcomidl::HintSeq::RawType*)&hints, (xcom::StringSeq::RawType*)&dependencies, (xcom::StringSeq::RawType*)&messages));
+        if(__exc_info.exception) xcomFindAndThrow(&__exc_info);
+        
+        return result;
+    }
+    
+    inline void IParser2::setCacheDirectory(const xcom::Char* directory) const
+    {
+        xcom::Environment __exc_info;
+        static_cast<IParser2Vtbl*>(static_cast<IParser2Raw*>(ptr_)->vptr_)->setCacheDirectory(ptr_, &__exc_info, directory);
+    if(__exc_info.exception) xcomFindAndThrow(&__exc_info);
+    
+    }
+    
+    inline xcom::Bool IParser2::parseBuffer(xcom::StringSeq const& includePaths, const xcom::Char* idlName, const xcom::Char* idlContents, xcomidl::IImportResolver const& resolver, xcomidl::TypeSeq& types, xcomidl::HintSeq& hints, xcom::StringSeq& dependencies, xcom::StringSeq& messages) const
+    {
+        xcom::Environment __exc_info;
+        xcom::Bool result(static_cast<IParser2Vtbl*>(static_cast<IParser2Raw*>(ptr_)->vptr_)->parseBuffer(ptr_, &__exc_info, (xcom::StringSeq::RawType const*)&includePaths, idlName, idlContents, (xcomidl::IImportResolverRaw*)resolver.ptr_, (xcomidl::TypeSeq::RawType*)&types, (xcomidl::HintSeq::RawType*)&hints, (xcom::StringSeq::RawType*)&dependencies, (xcom::StringSeq::RawType*)&messages));
+        if(__exc_info.exception) xcomFindAndThrow(&__exc_info);
+        
+        return result;
+    }
+    
     inline void ICodeGen::generate(xcomidl::TypeSeq const& types, xcomidl::HintSeq const& hints, const xcom::Char* idlFileName, xcom::StringSeq const& options) const
     {
         xcom::Environment __exc_info;
@@ -206,21 +395,44 @@ namespace xcomidl
     
     }
     
+    inline void ICodeGen2::generateToBuffers(xcomidl::TypeSeq const& types, xcomidl::HintSeq const& hints, const xcom::Char* idlFileName, xcom::StringSeq const& options, xcom::StringSeq& names, xcom::StringSeq& contents) const
+    {
+        xcom::Environment __exc_info;
+        static_cast<ICodeGen2Vtbl*>(static_cast<ICodeGen2Raw*>(ptr_)->vptr_)->generateToBuffers(ptr_, &__exc_info, (xcomidl::TypeSeq::RawType const*)&types, (xcomidl::HintSeq::RawType const*)&hints, idlFileName, (xcom::StringSeq::RawType const*)&options, (xcom::StringSeq::RawType*)&names, (xcom::StringSeq::RawType*)&contents);
+    if(__exc_info.exception) xcomFindAndThrow(&__exc_info);
+    
+    }
+    
 }
 #include <xcom/MDHelper.hpp>
 namespace xcom
 {
 
+    template<> struct TypeDesc<xcomidl::IImportResolver>
+    {
+        static void addSelf(IUnknownSeq& types);
+    };
+    
     template<> struct TypeDesc<xcomidl::IParser>
     {
         static void addSelf(IUnknownSeq& types);
     };
     
+    template<> struct TypeDesc<xcomidl::IParser2>
+    {
+        static void addSelf(IUnknownSeq& types);
+    };
+    
     template<> struct TypeDesc<xcomidl::ICodeGen>
     {
         static void addSelf(IUnknownSeq& types);
     };
     
+    template<> struct TypeDesc<xcomidl::ICodeGen2>
+    {
+        static void addSelf(IUnknownSeq& types);
+    };
+    
     template <>
     struct TypeDesc<xcomidl::CodeGenHintEnum>
     {
@@ -228,8 +440,8 @@ namespace xcom
         {
             if(!typeExists(types, "xcomidl.CodeGenHint"))
             {
-                Char const* elements[5] = { "GenImport", "GenType", "GenForward", "EnterNamespace", "LeaveNamespace",  };
-                addType(types, xcomCreateEnumMD("xcomidl.CodeGenHint", elements, 5));
+                Char const* elements[6] = { "GenImport", "GenType", "GenForward", "EnterNamespace", "LeaveNamespace", "NoThrow",  };
+                addType(types, xcomCreateEnumMD("xcomidl.CodeGenHint", elements, 6));
             }
         }
     };
@@ -290,6 +502,34 @@ namespace xcom
         }
     };
     
+    inline void TypeDesc<xcomidl::IImportResolver>::addSelf(IUnknownSeq& types)
+    {
+        if(!typeExists(types, "xcomidl.IImportResolver"))
+        {
+            void* cookie;
+            IUnknown base(findOrRegister(types, "xcom.IUnknown", &TypeDesc<xcom::IUnknown>::addSelf));
+            Char const* pnames[4];
+            IUnknownRaw* ptypes[4];
+            Int pmodes[4];
+            types.push_back(xcomCreateInterfaceMD("xcomidl.IImportResolver", &xcomidl::IImportResolver::thisInterfaceId(), base.detach(), &cookie));
+            
+            pnames[0] = "name";
+            pnames[1] = "path";
+            pnames[2] = "contents";
+            
+            ptypes[0] = rawFindMetadata(types, "string");
+            ptypes[1] = rawFindMetadata(types, "string");
+            ptypes[2] = rawFindMetadata(types, "string");
+            
+            pmodes[0] = 0;
+            pmodes[1] = 1;
+            pmodes[2] = 1;
+            
+            xcomAddMethodToItf(cookie, "resolve", rawFindMetadata(types, "bool"), 3, pmodes, ptypes, pnames);
+            
+        }
+    }
+    
     inline void TypeDesc<xcomidl::IParser>::addSelf(IUnknownSeq& types)
     {
         if(!typeExists(types, "xcomidl.IParser"))
@@ -324,6 +564,80 @@ namespace xcom
         }
     }
     
+    inline void TypeDesc<xcomidl::IParser2>::addSelf(IUnknownSeq& types)
+    {
+        if(!typeExists(types, "xcomidl.IParser2"))
+        {
+            void* cookie;
+            IUnknown base(findOrRegister(types, "xcomidl.IParser", &TypeDesc<xcomidl::IParser>::addSelf));
+            Char const* pnames[9];
+            IUnknownRaw* ptypes[9];
+            Int pmodes[9];
+            types.push_back(xcomCreateInterfaceMD("xcomidl.IParser2", &xcomidl::IParser2::thisInterfaceId(), base.detach(), &cookie));
+            
+            pnames[0] = "includePaths";
+            pnames[1] = "idlFile";
+            pnames[2] = "types";
+            pnames[3] = "hints";
+            pnames[4] = "dependencies";
+            pnames[5] = "messages";
+            
+            ptypes[0] = rawFindOrReg(types, "xcom.StringSeq", &TypeDesc<xcom::StringSeq>::addSelf);
+            ptypes[1] = rawFindMetadata(types, "string");
+            ptypes[2] = rawFindOrReg(types, "xcomidl.TypeSeq", &TypeDesc<xcomidl::TypeSeq>::addSelf);
+            ptypes[3] = rawFindOrReg(types, "xcomidl.HintSeq", &TypeDesc<xcomidl::HintSeq>::addSelf);
+            ptypes[4] = rawFindOrReg(types, "xcom.StringSeq", &TypeDesc<xcom::StringSeq>::addSelf);
+            ptypes[5] = rawFindOrReg(types, "xcom.StringSeq", &TypeDesc<xcom::StringSeq>::addSelf);
+            
+            pmodes[0] = 0;
+            pmodes[1] = 0;
+            pmodes[2] = 1;
+            pmodes[3] = 1;
+            pmodes[4] = 1;
+            pmodes[5] = 1;
+            
+            xcomAddMethodToItf(cookie, "parseWithDependencies", rawFindMetadata(types, "bool"), 6, pmodes, ptypes, pnames);
+            
+            pnames[0] = "directory";
+            
+            ptypes[0] = rawFindMetadata(types, "string");
+            
+            pmodes[0] = 0;
+            
+            xcomAddMethodToItf(cookie, "setCacheDirectory", rawFindMetadata(types, "void"), 1, pmodes, ptypes, pnames);
+            
+            pnames[0] = "includePaths";
+            pnames[1] = "idlName";
+            pnames[2] = "idlContents";
+            pnames[3] = "resolver";
+            pnames[4] = "types";
+            pnames[5] = "hints";
+            pnames[6] = "dependencies";
+            pnames[7] = "messages";
+            
+            ptypes[0] = rawFindOrReg(types, "xcom.StringSeq", &TypeDesc<xcom::StringSeq>::addSelf);
+            ptypes[1] = rawFindMetadata(types, "string");
+            ptypes[2] = rawFindMetadata(types, "string");
+            ptypes[3] = rawFindOrReg(types, "xcomidl.IImportResolver", &TypeDesc<xcomidl::IImportResolver>::addSelf);
+            ptypes[4] = rawFindOrReg(types, "xcomidl.TypeSeq", &TypeDesc<xcomidl::TypeSeq>::addSelf);
+            ptypes[5] = rawFindOrReg(types, "xcomidl.HintSeq", &TypeDesc<xcomidl::HintSeq>::addSelf);
+            ptypes[6] = rawFindOrReg(types, "xcom.StringSeq", &TypeDesc<xcom::StringSeq>::addSelf);
+            ptypes[7] = rawFindOrReg(types, "xcom.StringSeq", &TypeDesc<xcom::StringSeq>::addSelf);
+            
+            pmodes[0] = 0;
+            pmodes[1] = 0;
+            pmodes[2] = 0;
+            pmodes[3] = 0;
+            pmodes[4] = 1;
+            pmodes[5] = 1;
+            pmodes[6] = 1;
+            pmodes[7] = 1;
+            
+            xcomAddMethodToItf(cookie, "parseBuffer", rawFindMetadata(types, "bool"), 8, pmodes, ptypes, pnames);
+            
+        }
+    }
+    
     inline void TypeDesc<xcomidl::ICodeGen>::addSelf(IUnknownSeq& types)
     {
         if(!typeExists(types, "xcomidl.ICodeGen"))
@@ -355,6 +669,43 @@ namespace xcom
         }
     }
     
+    inline void TypeDesc<xcomidl::ICodeGen2>::addSelf(IUnknownSeq& types)
+    {
+        if(!typeExists(types, "xcomidl.ICodeGen2"))
+        {
+            void* cookie;
+            IUnknown base(findOrRegister(types, "xcomidl.ICodeGen", &TypeDesc<xcomidl::ICodeGen>::addSelf));
+            Char const* pnames[7];
+            IUnknownRaw* ptypes[7];
+            Int pmodes[7];
+            types.push_back(xcomCreateInterfaceMD("xcomidl.ICodeGen2", &xcomidl::ICodeGen2::thisInterfaceId(), base.detach(), &cookie));
+            
+            pnames[0] = "types";
+            pnames[1] = "hints";
+            pnames[2] = "idlFileName";
+            pnames[3] = "options";
+            pnames[4] = "names";
+            pnames[5] = "contents";
+            
+            ptypes[0] = rawFindOrReg(types, "xcomidl.TypeSeq", &TypeDesc<xcomidl::TypeSeq>::addSelf);
+            ptypes[1] = rawFindOrReg(types, "xcomidl.HintSeq", &TypeDesc<xcomidl::HintSeq>::addSelf);
+            ptypes[2] = rawFindMetadata(types, "string");
+            ptypes[3] = rawFindOrReg(types, "xcom.StringSeq", &TypeDesc<xcom::StringSeq>::addSelf);
+            ptypes[4] = rawFindOrReg(types, "xcom.StringSeq", &TypeDesc<xcom::StringSeq>::addSelf);
+            ptypes[5] = rawFindOrReg(types, "xcom.StringSeq", &TypeDesc<xcom::StringSeq>::addSelf);
+            
+            pmodes[0] = 0;
+            pmodes[1] = 0;
+            pmodes[2] = 0;
+            pmodes[3] = 0;
+            pmodes[4] = 1;
+            pmodes[5] = 1;
+            
+            xcomAddMethodToItf(cookie, "generateToBuffers", rawFindMetadata(types, "void"), 6, pmodes, ptypes, pnames);
+            
+        }
+    }
+    
 } // namespace xcom
 
 #include <xcom/ExcHelper.hpp>
@@ -5,6 +5,73 @@
 namespace xcomidl
 {
 
+    template <class Impl>
+    class IImportResolverTie : public IImportResolverRaw
+    {
+    public:
+        static xcom::IUnknownRaw* queryInterface__call(void* ptr, ::xcom::Environment* __exc_info, xcom::GUID const* iid)
+        {
+            try {
+            return static_cast<Impl*>(static_cast<IImportResolverTie<Impl>*>(ptr))->queryInterface(*(xcom::GUID*)iid).detach();
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            return xcom::IUnknown().detach();
+            
+        }
+        
+        static xcom::GUID getInterfaceId__call(void*, ::xcom::Environment*)
+        {
+            return IImportResolver::thisInterfaceId();
+        }
+        
+        static xcom::Int addRef__call(void* ptr, ::xcom::Environment* __exc_info)
+        {
+            try {
+            return static_cast<Impl*>(static_cast<IImportResolverTie<Impl>*>(ptr))->addRef();
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            return xcom::Int();
+            
+        }
+        
+        static xcom::Int release__call(void* ptr, ::xcom::Environment* __exc_info)
+        {
+            try {
+            return static_cast<Impl*>(static_cast<IImportResolverTie<Impl>*>(ptr))->release();
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            return xcom::Int();
+            
+        }
+        
+        static xcom::Bool resolve__call(void* ptr, ::xcom::Environment* __exc_info, const xcom::Char* name, xcom::Char** path, xcom::Char** contents)
+        {
+            try {
+            return static_cast<Impl*>(static_cast<IImportResolverTie<Impl>*>(ptr))->resolve(name, *(xcom::String*)path, *(xcom::String*)contents);
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            return xcom::Bool();
+            
+        }
+        
+        
+        
+        IImportResolverTie()
+        {
+            vptr_ = &IImportResolverTieVtbl;
+        }
+    
+    private:
+        static IImportResolverVtbl IImportResolverTieVtbl;
+    };
+    
+    template <class Impl>
+    IImportResolverVtbl IImportResolverTie<Impl>::IImportResolverTieVtbl =
+    {
+        &IImportResolverTie<Impl>::queryInterface__call,
+        &IImportResolverTie<Impl>::getInterfaceId__call,
+        &IImportResolverTie<Impl>::addRef__call,
+        &IImportResolverTie<Impl>::release__call,
+        &IImportResolverTie<Impl>::resolve__call,
+        
+    };
+    
     template <class Impl>
     class IParserTie : public IParserRaw
     {
@@ -72,6 +139,103 @@ namespace xcomidl
         
     };
     
+    template <class Impl>
+    class IParser2Tie : public IParser2Raw
+    {
+    public:
+        static xcom::IUnknownRaw* queryInterface__call(void* ptr, ::xcom::Environment* __exc_info, xcom::GUID const* iid)
+        {
+            try {
+            return static_cast<Impl*>(static_cast<IParser2Tie<Impl>*>(ptr))->queryInterface(*(xcom::GUID*)iid).detach();
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            return xcom::IUnknown().detach();
+            
+        }
+        
+        static xcom::GUID getInterfaceId__call(void*, ::xcom::Environment*)
+        {
+            return IParser2::thisInterfaceId();
+        }
+        
+        static xcom::Int addRef__call(void* ptr, ::xcom::Environment* __exc_info)
+        {
+            try {
+            return static_cast<Impl*>(static_cast<IParser2Tie<Impl>*>(ptr))->addRef();
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            return xcom::Int();
+            
+        }
+        
+        static xcom::Int release__call(void* ptr, ::xcom::Environment* __exc_info)
+        {
+            try {
+            return static_cast<Impl*>(static_cast<IParser2Tie<Impl>*>(ptr))->release();
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            return xcom::Int();
+            
+        }
+        
+        static xcom::Bool parse__call(void* ptr, ::xcom::Environment* __exc_info, xcom::StringSeq::RawType const* includePaths, const xcom::Char* idlFile, xcomidl::TypeSeq::RawType* types, xcomidl::HintSeq::RawType* hints, xcom::StringSeq::RawType* messages)
+        {
+            try {
+            return static_cast<Impl*>(static_cast<IParser2Tie<Impl>*>(ptr))->parse(*(xcom::StringSeq*)includePaths, idlFile, *(xcomidl::TypeSeq*)types, *(xcomidl::HintSeq*)hints, *(xcom::StringSeq*)messages);
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            return xcom::Bool();
+            
+        }
+        
+        static xcom::Bool parseWithDependencies__call(void* ptr, ::xcom::Environment* __exc_info, xcom::StringSeq::RawType const* includePaths, const xcom::Char* idlFile, xcomidl::TypeSeq::RawType* types, xcomidl::HintSeq::RawType* hints, xcom::StringSeq::RawType* dependencies, xcom::StringSeq::RawType* messages)
+        {
+            try {
+            return static_cast<Impl*>(static_cast<IParser2Tie<Impl>*>(ptr))->parseWithDependencies(*(xcom::StringSeq*)includePaths, idlFile, *(xcomidl::TypeSeq*)types, *(xcomidl::HintSeq*)hints, *(xcom::StringSeq*)dependencies, *(xcom::StringSeq*)messages);
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            return xcom::Bool();
+            
+        }
+        
+        static void setCacheDirectory__call(void* ptr, ::xcom::Environment* __exc_info, const xcom::Char* directory)
+        {
+            try
+            {
+                static_cast<Impl*>(static_cast<IParser2Tie<Impl>*>(ptr))->setCacheDirectory(directory);
+                
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            }
+            
+        static xcom::Bool parseBuffer__call(void* ptr, ::xcom::Environment* __exc_info, xcom::StringSeq::RawType const* includePaths, const xcom::Char* idlName, const xcom::Char* idlContents,  xcomidl::IImportResolverRaw* resolver, xcomidl::TypeSeq::RawType* types, xcomidl::HintSeq::RawType* hints, xcom::StringSeq::RawType* dependencies, xcom::StringSeq::RawType* messages)
+        {
+            try {
+            return static_cast<Impl*>(static_cast<IParser2Tie<Impl>*>(ptr))->parseBuffer(*(xcom::StringSeq*)includePaths, idlName, idlContents, *(xcomidl::IImportResolver*)&resolver, *(xcomidl::TypeSeq*)types, *(xcomidl::HintSeq*)hints, *(xcom::StringSeq*)dependencies, *(xcom::StringSeq*)messages);
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            return xcom::Bool();
+            
+        }
+        
+        
+        
+        IParser2Tie()
+        {
+            vptr_ = &IParser2TieVtbl;
+        }
+    
+    private:
+        static IParser2Vtbl IParser2TieVtbl;
+    };
+    
+    template <class Impl>
+    IParser2Vtbl IParser2Tie<Impl>::IParser2TieVtbl =
+    {
+        &IParser2Tie<Impl>::queryInterface__call,
+        &IParser2Tie<Impl>::getInterfaceId__call,
+        &IParser2Tie<Impl>::addRef__call,
+        &IParser2Tie<Impl>::release__call,
+        &IParser2Tie<Impl>::parse__call,
+        &IParser2Tie<Impl>::parseWithDependencies__call,
+        &IParser2Tie<Impl>::setCacheDirectory__call,
+        &IParser2Tie<Impl>::parseBuffer__call,
+        
+    };
+    
     template <class Impl>
     class ICodeGenTie : public ICodeGenRaw
     {
@@ -139,6 +303,83 @@ namespace xcomidl
         
     };
     
+    template <class Impl>
+    class ICodeGen2Tie : public ICodeGen2Raw
+    {
+    public:
+        static xcom::IUnknownRaw* queryInterface__call(void* ptr, ::xcom::Environment* __exc_info, xcom::GUID const* iid)
+        {
+            try {
+            return static_cast<Impl*>(static_cast<ICodeGen2Tie<Impl>*>(ptr))->queryInterface(*(xcom::GUID*)iid).detach();
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            return xcom::IUnknown().detach();
+            
+        }
+        
+        static xcom::GUID getInterfaceId__call(void*, ::xcom::Environment*)
+        {
+            return ICodeGen2::thisInterfaceId();
+        }
+        
+        static xcom::Int addRef__call(void* ptr, ::xcom::Environment* __exc_info)
+        {
+            try {
+            return static_cast<Impl*>(static_cast<ICodeGen2Tie<Impl>*>(ptr))->addRef();
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            return xcom::Int();
+            
+        }
+        
+        static xcom::Int release__call(void* ptr, ::xcom::Environment* __exc_info)
+        {
+            try {
+            return static_cast<Impl*>(static_cast<ICodeGen2Tie<Impl>*>(ptr))->release();
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            return xcom::Int();
+            
+        }
+        
+        static void generate__call(void* ptr, ::xcom::Environment* __exc_info, xcomidl::TypeSeq::RawType const* types, xcomidl::HintSeq::RawType const* hints, const xcom::Char* idlFileName, xcom::StringSeq::RawType const* options)
+        {
+            try
+            {
+                static_cast<Impl*>(static_cast<ICodeGen2Tie<Impl>*>(ptr))->generate(*(xcomidl::TypeSeq*)types, *(xcomidl::HintSeq*)hints, idlFileName, *(xcom::StringSeq*)options);
+                
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            }
+            
+        static void generateToBuffers__call(void* ptr, ::xcom::Environment* __exc_info, xcomidl::TypeSeq::RawType const* types, xcomidl::HintSeq::RawType const* hints, const xcom::Char* idlFileName, xcom::StringSeq::RawType const* options, xcom::StringSeq::RawType* names, xcom::StringSeq::RawType* contents)
+        {
+            try
+            {
+                static_cast<Impl*>(static_cast<ICodeGen2Tie<Impl>*>(ptr))->generateToBuffers(*(xcomidl::TypeSeq*)types, *(xcomidl::HintSeq*)hints, idlFileName, *(xcom::StringSeq*)options, *(xcom::StringSeq*)names, *(xcom::StringSeq*)contents);
+                
+            } catch(xcom::UserExc& ue) { ue.detach(__exc_info); }
+            }
+            
+        
+        
+        ICodeGen2Tie()
+        {
+            vptr_ = &ICodeGen2TieVtbl;
+        }
+    
+    private:
+        static ICodeGen2Vtbl ICodeGen2TieVtbl;
+    };
+    
+    template <class Impl>
+    ICodeGen2Vtbl ICodeGen2Tie<Impl>::ICodeGen2TieVtbl =
+    {
+        &ICodeGen2Tie<Impl>::queryInterface__call,
+        &ICodeGen2Tie<Impl>::getInterfaceId__call,
+        &ICodeGen2Tie<Impl>::addRef__call,
+        &ICodeGen2Tie<Impl>::release__call,
+        &ICodeGen2Tie<Impl>::generate__call,
+        &ICodeGen2Tie<Impl>::generateToBuffers__call,
+        
+    };
+    
 }
 
 #endif
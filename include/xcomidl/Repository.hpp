@@ -33,6 +33,8 @@
 
 #include <xcomidl/ParserTypes.hpp>    
 #include <vector>
+#include <string>
+#include <unordered_map>
 
 namespace xcomidl
 {
@@ -52,11 +54,32 @@ inline bool nameMatches(xcom::metadata::IType const& type, char const* name)
     return false;
 }
 
+/**
+ * Returns the name the type is searched with. That is the scoped name
+ * for declared types and the in-idl name for built in types.
+ */
+inline std::string typeName(xcom::metadata::IType const& type)
+{
+    if(!xcom::metadata::isBuiltin(type.getKind()))
+    {
+        return xcom::cast<xcom::metadata::IDeclared>(type).getName().c_str();
+    }
+
+    return xcom::metadata::kindAsString(type.getKind());
+}
+
+/**
+ * Name of the return value entry in the parameters of a method.
+ */
+char const* const RETURN_NAME = "<<return>>";
+
 /**
  * Manages a repository of IType's.
  * Supports searching types by scoped names.
  * Returns proper IType's for built in types when searched with
  * in-idl names.
+ * Names are kept in a hash index so searching does not depend on the
+ * number of types in the repository.
  */
 class Repository
 {
@@ -67,6 +90,13 @@ public:
     Repository(TypeSeq const& types)
     : types_(types)
     {
+        TypeSeq::const_iterator i = types_.begin(), end = types_.end();
+
+        while(i != end)
+        {
+            indexType(*i);
+            ++i;
+        }
     }
     
     /**
@@ -76,19 +106,19 @@ public:
     {
         using xcom::metadata::Type;
 
-        types_.push_back(new Type(xcom::metadata::TypeKind::Void));
-        types_.push_back(new Type(xcom::metadata::TypeKind::Bool));
-        types_.push_back(new Type(xcom::metadata::TypeKind::Octet));
-        types_.push_back(new Type(xcom::metadata::TypeKind::Short));
-        types_.push_back(new Type(xcom::metadata::TypeKind::Int));
-        types_.push_back(new Type(xcom::metadata::TypeKind::Long));
-        types_.push_back(new Type(xcom::metadata::TypeKind::Float));
-        types_.push_back(new Type(xcom::metadata::TypeKind::Double));
-        types_.push_back(new Type(xcom::metadata::TypeKind::Char));
-        types_.push_back(new Type(xcom::metadata::TypeKind::WChar));
-        types_.push_back(new Type(xcom::metadata::TypeKind::String));
-        types_.push_back(new Type(xcom::metadata::TypeKind::WString));
-        types_.push_back(new Type(xcom::metadata::TypeKind::Any));
+        addType(new Type(xcom::metadata::TypeKind::Void));
+        addType(new Type(xcom::metadata::TypeKind::Bool));
+        addType(new Type(xcom::metadata::TypeKind::Octet));
+        addType(new Type(xcom::metadata::TypeKind::Short));
+        addType(new Type(xcom::metadata::TypeKind::Int));
+        addType(new Type(xcom::metadata::TypeKind::Long));
+        addType(new Type(xcom::metadata::TypeKind::Float));
+        addType(new Type(xcom::metadata::TypeKind::Double));
+        addType(new Type(xcom::metadata::TypeKind::Char));
+        addType(new Type(xcom::metadata::TypeKind::WChar));
+        addType(new Type(xcom::metadata::TypeKind::String));
+        addType(new Type(xcom::metadata::TypeKind::WString));
+        addType(new Type(xcom::metadata::TypeKind::Any));
     }
 
     ~Repository()
@@ -104,6 +134,7 @@ public:
     void addType(xcom::metadata::IType const& type)
     {
         types_.push_back(type);
+        indexType(type);
     }
 
     /**
@@ -112,16 +143,11 @@ public:
      */
     xcom::metadata::IType findType(std::string const& name) const
     {
-        TypeSeq::const_iterator i = types_.begin(), end = types_.end();
-        
-        while(i != end)
-        {
-            if(nameMatches(*i, name.c_str()))
-            {
-                return *i;
-            }
+        TypeIndex::const_iterator i = index_.find(name);
 
-            ++i;
+        if(i != index_.end())
+        {
+            return i->second;
         }
         
         return 0;
@@ -136,7 +162,19 @@ public:
     }
     
 private:
+    typedef std::unordered_map<std::string, xcom::metadata::IType> TypeIndex;
+
     TypeSeq types_;
+    TypeIndex index_;
+
+    /**
+     * Add the type to the name index. If a type with the same name
+     * is already indexed the first one is kept as a linear search would.
+     */
+    void indexType(xcom::metadata::IType const& type)
+    {
+        index_.insert(TypeIndex::value_type(typeName(type), type));
+    }
     
     /**
      * Copy constructor.
@@ -0,0 +1,178 @@
+/**
+ * File    : StaticMetadata.hpp
+ * Author  : Emir Uner
+ * Summary : Registration of metadata described by constant tables.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef XCOMIDL_STATICMETADATA_HPP_INCLUDED
+#define XCOMIDL_STATICMETADATA_HPP_INCLUDED
+
+#include <xcomidl/TypeRegistry.hpp>
+
+#include <vector>
+
+namespace xcomidl
+{
+
+/**
+ * Reference to a type from a metadata table. Declared types are found
+ * or registered through addSelf, built-in types have no addSelf and are
+ * only searched. The hash is zero unless the code was generated with
+ * --hashed-registry, in which case the type is searched through the
+ * hashed type index.
+ */
+struct TypeRef
+{
+    char const* name;
+    unsigned int hash;
+    void (*addSelf)(xcom::IUnknownSeq&);
+};
+
+/**
+ * Members of a struct, in declaration order.
+ */
+struct StructTable
+{
+    char const* name;
+    int size;
+    int memberCount;
+    TypeRef const* types;
+    xcom::Char const* const* names;
+    xcom::Int const* offsets;
+};
+
+/**
+ * A method of an interface. The tables have one entry per parameter,
+ * excluding the return value.
+ */
+struct MethodTable
+{
+    char const* name;
+    TypeRef result;
+    int paramCount;
+    xcom::Int const* modes;
+    TypeRef const* types;
+    xcom::Char const* const* names;
+};
+
+/**
+ * Methods of an interface, in declaration order. The base has a nil
+ * name for interfaces without a base.
+ */
+struct InterfaceTable
+{
+    char const* name;
+    TypeRef base;
+    int methodCount;
+    MethodTable const* methods;
+};
+
+/**
+ * Find the referred type, registering it first if it is not registered.
+ * Returns a new reference.
+ */
+inline xcom::IUnknownRaw* rawFindType(xcom::IUnknownSeq& types,
+                                      TypeRef const& type)
+{
+    if(type.addSelf == 0)
+    {
+        if(type.hash != 0)
+        {
+            return hashedRawFindMetadata(types, type.name, type.hash);
+        }
+
+        return xcom::rawFindMetadata(types, type.name);
+    }
+    
+    if(type.hash != 0)
+    {
+        return hashedRawFindOrReg(types, type.name, type.hash, type.addSelf);
+    }
+
+    return xcom::rawFindOrReg(types, type.name, type.addSelf);
+}
+
+/**
+ * Register the struct described by the table.
+ */
+inline void registerStruct(xcom::IUnknownSeq& types, StructTable const& table)
+{
+    std::vector<xcom::IUnknownRaw*> mtypes(table.memberCount);
+
+    for(int i = 0; i < table.memberCount; ++i)
+    {
+        mtypes[i] = rawFindType(types, table.types[i]);
+    }
+
+    // The tables are only read, they are not const in the C interface.
+    xcom::addType(types, xcomCreateStructMD(
+                      table.name, table.size, table.memberCount,
+                      mtypes.empty() ? 0 : &mtypes[0],
+                      const_cast<xcom::Char const**>(table.names),
+                      const_cast<xcom::Int*>(table.offsets)));
+}
+
+/**
+ * Register the interface described by the table.
+ */
+inline void registerInterface(xcom::IUnknownSeq& types,
+                              InterfaceTable const& table,
+                              xcom::GUID const* id)
+{
+    void* cookie;
+    xcom::IUnknown base;
+
+    if(table.base.name != 0)
+    {
+        base = xcom::IUnknown(rawFindType(types, table.base));
+    }
+    
+    types.push_back(xcomCreateInterfaceMD(table.name, id, base.detach(),
+                                          &cookie));
+
+    std::vector<xcom::IUnknownRaw*> ptypes;
+    
+    for(int i = 0; i < table.methodCount; ++i)
+    {
+        MethodTable const& method = table.methods[i];
+
+        ptypes.resize(method.paramCount);
+        
+        for(int p = 0; p < method.paramCount; ++p)
+        {
+            ptypes[p] = rawFindType(types, method.types[p]);
+        }
+
+        xcomAddMethodToItf(cookie, method.name,
+                           rawFindType(types, method.result),
+                           method.paramCount,
+                           const_cast<xcom::Int*>(method.modes),
+                           ptypes.empty() ? 0 : &ptypes[0],
+                           const_cast<xcom::Char const**>(method.names));
+    }
+}
+
+} // namespace xcomidl
+
+#endif
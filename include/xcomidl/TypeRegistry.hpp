@@ -0,0 +1,270 @@
+/**
+ * File    : TypeRegistry.hpp
+ * Author  : Emir Uner
+ * Summary : Hashed lookup of metadata in type sequences.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_TYPEREGISTRY_HPP_INCLUDED
+#define XCOMIDL_TYPEREGISTRY_HPP_INCLUDED
+
+// The type indexes are thread local.
+#if (defined(_MSC_VER) && _MSC_VER < 1900) || \
+    (!defined(_MSC_VER) && __cplusplus < 201103L)
+#error "xcomidl/TypeRegistry.hpp needs C++11, as does the code generated \
+with --hashed-registry or --static-metadata"
+#endif
+
+#include <xcom/MDHelper.hpp>
+#include <xcom/metadata/Type.hpp>
+#include <xcom/metadata/Declared.hpp>
+
+#include <xcomidl/Hash.hpp>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+namespace xcomidl
+{
+
+/**
+ * Index of the metadata objects in a type sequence by name hash.
+ * Registration only appends to type sequences, so entries appended
+ * since the last search are indexed when it is searched.
+ * The index holds no references, the addresses of the indexed objects
+ * are only compared with the objects in the sequence, which keeps
+ * them alive. Before a search the last indexed entry is checked
+ * against the sequence, and a found entry is checked too. The index
+ * is rebuilt if the sequence was shrunk or an entry differs, as
+ * happens when another sequence takes the address of the indexed one.
+ */
+class TypeIndex
+{
+public:
+    TypeIndex()
+    : types_(0), indexed_(0), last_(0)
+    {
+    }
+
+    /**
+     * Whether this is the index of the given sequence.
+     */
+    bool indexes(xcom::IUnknownSeq const& types) const
+    {
+        return types_ == &types;
+    }
+
+    /**
+     * Make this an empty index of the given sequence.
+     */
+    void reset(xcom::IUnknownSeq const& types)
+    {
+        entries_.clear();
+        types_ = &types;
+        indexed_ = 0;
+        last_ = 0;
+    }
+    
+    /**
+     * Position of the named type in the indexed sequence, -1 if it is
+     * not there.
+     */
+    int find(xcom::IUnknownSeq const& types, char const* name,
+             unsigned int hash)
+    {
+        int position = lookup(types, name, hash);
+
+        if(position == STALE)
+        {
+            reset(types);
+            position = lookup(types, name, hash);
+        }
+
+        return position < 0 ? -1 : position;
+    }
+    
+private:
+    enum { STALE = -2 };
+    
+    struct Entry
+    {
+        std::string name;
+        void const* md;
+        int position;
+    };
+
+    typedef std::unordered_multimap<unsigned int, Entry> EntryMap;
+
+    EntryMap entries_;
+    xcom::IUnknownSeq const* types_;
+    std::size_t indexed_;
+    void const* last_; // last indexed object
+
+    /**
+     * Name the metadata is registered with. That is the scoped name for
+     * declared types and the in-idl name for built in types.
+     */
+    static std::string nameOf(xcom::IUnknown const& md)
+    {
+        xcom::metadata::IType type(xcom::cast<xcom::metadata::IType>(md));
+
+        if(xcom::metadata::isBuiltin(type.getKind()))
+        {
+            return xcom::metadata::kindAsString(type.getKind());
+        }
+        
+        return xcom::cast<xcom::metadata::IDeclared>(type).getName().c_str();
+    }
+
+    /**
+     * Index the entries added since the last search and search.
+     * Returns STALE if the index does not match the sequence.
+     */
+    int lookup(xcom::IUnknownSeq const& types, char const* name,
+               unsigned int hash)
+    {
+        if(types.size() < indexed_ ||
+           (indexed_ != 0 && types[indexed_ - 1].ptr_ != last_))
+        {
+            return STALE;
+        }
+        
+        while(indexed_ < types.size())
+        {
+            Entry entry;
+
+            entry.name = nameOf(types[indexed_]);
+            entry.md = types[indexed_].ptr_;
+            entry.position = (int)indexed_;
+            entries_.insert(
+                EntryMap::value_type(nameHash(entry.name.c_str()), entry));
+            last_ = entry.md;
+            ++indexed_;
+        }
+
+        std::pair<EntryMap::const_iterator, EntryMap::const_iterator> range(
+            entries_.equal_range(hash));
+
+        for(EntryMap::const_iterator i = range.first; i != range.second; ++i)
+        {
+            if(i->second.name == name)
+            {
+                if(types[i->second.position].ptr_ != i->second.md)
+                {
+                    return STALE;
+                }
+
+                return i->second.position;
+            }
+        }
+
+        return -1;
+    }
+};
+
+/**
+ * Position of the named type in the sequence, -1 if it is not there.
+ * Every thread keeps the indexes of the few sequences it searched
+ * last, registration searches the same sequence many times in a row.
+ * The sequences themselves must not be shared between threads.
+ */
+inline int indexedFind(xcom::IUnknownSeq const& types, char const* name,
+                       unsigned int hash)
+{
+    enum { INDEX_COUNT = 4 };
+
+    static thread_local TypeIndex indexes[INDEX_COUNT];
+    static thread_local int next = 0;
+
+    for(int i = 0; i < INDEX_COUNT; ++i)
+    {
+        if(indexes[i].indexes(types))
+        {
+            return indexes[i].find(types, name, hash);
+        }
+    }
+
+    TypeIndex& index = indexes[next];
+
+    next = (next + 1) % INDEX_COUNT;
+    index.reset(types);
+    
+    return index.find(types, name, hash);
+}
+
+/**
+ * Hashed equivalent of typeExists.
+ */
+inline bool hashedTypeExists(xcom::IUnknownSeq const& types, char const* name,
+                             unsigned int hash)
+{
+    return indexedFind(types, name, hash) >= 0;
+}
+
+/**
+ * Hashed equivalent of rawFindMetadata. Returns a new reference.
+ * Names that are not in the sequence, such as built-in types that are
+ * not registered, are left to rawFindMetadata.
+ */
+inline xcom::IUnknownRaw* hashedRawFindMetadata(xcom::IUnknownSeq const& types,
+                                                char const* name,
+                                                unsigned int hash)
+{
+    int position = indexedFind(types, name, hash);
+
+    if(position < 0)
+    {
+        return xcom::rawFindMetadata(types, name);
+    }
+    
+    return xcom::IUnknown(types[position]).detach();
+}
+
+/**
+ * Hashed equivalent of rawFindOrReg. Returns a new reference.
+ */
+inline xcom::IUnknownRaw* hashedRawFindOrReg(
+    xcom::IUnknownSeq& types, char const* name, unsigned int hash,
+    void (*addSelf)(xcom::IUnknownSeq&))
+{
+    if(!hashedTypeExists(types, name, hash))
+    {
+        addSelf(types);
+    }
+
+    return hashedRawFindMetadata(types, name, hash);
+}
+
+/**
+ * Hashed equivalent of findOrRegister.
+ */
+inline xcom::IUnknown hashedFindOrRegister(
+    xcom::IUnknownSeq& types, char const* name, unsigned int hash,
+    void (*addSelf)(xcom::IUnknownSeq&))
+{
+    return xcom::IUnknown(hashedRawFindOrReg(types, name, hash, addSelf));
+}
+
+} // namespace xcomidl
+
+#endif
@@ -33,34 +33,40 @@ using namespace xcom::metadata;
 namespace
 {
 
-char const* adoptTmpl =
+TextTmpl::Source adoptTmpl =
+{
 "static @arrayName@ adopt(RawType const& src)\n"
 "{\t\n"
     "@arrayName@ result;\n"
     "::memcpy(&result, &src, sizeof(RawType));\n"
     "return result;\v\n"
-"}\n";
+"}\n"
+};
     
-char const* arrayTmpl =
+TextTmpl::Source arrayTmpl =
+{
 "class @arrayName@\n"
 " : public xcom::@simple@ArrayBase<@typename@, @size@, @rawtypename@>\n"
 "{\t\n"
     "@adopt@\v\n"
-"};\n";
+"};\n"
+};
 
-char const* metadataTmpl =
+TextTmpl::Source metadataTmpl =
+{
 "template <>\n"
 "struct TypeDesc<@scopedName@>\n"
 "{\t\n"
     "static void addSelf(IUnknownSeq& types)\n"
     "{\t\n"
-        "if(!typeExists(types, \"@idlName@\"))\n"
+        "if(!@typeExists@)\n"
         "{\t\n"
             "addType(types, xcomCreateArrayMD(\"@idlName@\", "
                                  "@find@, @size@));\v\n"
         "}\v\n"
     "}\v\n"
-"};\n";
+"};\n"
+};
     
 std::string genAdopt(IArray const& type)
 {
@@ -70,8 +76,9 @@ std::string genAdopt(IArray const& type)
     
 } // namespace <unnamed>
 
-ArrayGen::ArrayGen(IArray const& type, RuleBase& rules)
-: type_(type), rules_(rules)
+ArrayGen::ArrayGen(IArray const& type, RuleBase& rules,
+                   CodeGenOptions const& options)
+: type_(type), rules_(rules), options_(options)
 {
 }
 
@@ -110,9 +117,9 @@ std::string ArrayGen::genMetadata()
     TextTmpl tmpl(metadataTmpl, 4);
     
     tmpl.addParam(scopedName(type_.getName().c_str()));
+    tmpl.addParam(genTypeExists(type_.getName().c_str(), options_));
     tmpl.addParam(type_.getName().c_str());
-    tmpl.addParam(type_.getName().c_str());
-    tmpl.addParam(genRawFind(type_.getElementType()));
+    tmpl.addParam(genRawFind(type_.getElementType(), options_));
     tmpl.addParam(intToStr(type_.getSize()));
     
     return tmpl();
@@ -28,6 +28,7 @@
 
 #include <xcom/metadata/Array.hpp>
 #include "RuleBase.hpp"
+#include "CodeGenOptions.hpp"
 
 /**
  * Code generator for array's
@@ -35,7 +36,8 @@
 class ArrayGen
 {
 public:
-    ArrayGen(xcom::metadata::IArray const& type, RuleBase& rules);
+    ArrayGen(xcom::metadata::IArray const& type, RuleBase& rules,
+             CodeGenOptions const& options);
 
     /**
      * Get the code generated for this array.
@@ -50,6 +52,7 @@ public:
 private:
     xcom::metadata::IArray type_;
     RuleBase& rules_;
+    CodeGenOptions const& options_;
 };
 
 #endif
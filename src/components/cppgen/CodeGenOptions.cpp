@@ -0,0 +1,86 @@
+/**
+ * File    : CodeGenOptions.cpp
+ * Author  : Emir Uner
+ * Summary : Options of a code generation run.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "CodeGenOptions.hpp"
+
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+
+/**
+ * Return true if the option is given.
+ */
+bool haveOption(xcom::StringSeq const& options, char const* name)
+{
+    xcom::StringSeq::const_iterator i;
+
+    for(i = options.begin(); i != options.end(); ++i)
+    {
+        if(std::string(i->c_str()) == name)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Number given by a "--name=N" option, the default if not given.
+ */
+int intOption(xcom::StringSeq const& options, std::string const& prefix,
+              int defaultValue)
+{
+    xcom::StringSeq::const_iterator i;
+
+    for(i = options.begin(); i != options.end(); ++i)
+    {
+        std::string option(i->c_str());
+
+        if(option.compare(0, prefix.size(), prefix) == 0)
+        {
+            return std::atoi(option.c_str() + prefix.size());
+        }
+    }
+
+    return defaultValue;
+}
+    
+} // namespace <unnamed>
+
+CodeGenOptions::CodeGenOptions(xcom::StringSeq const& options)
+: cxx11(haveOption(options, "--cxx11")),
+  hashedRegistry(haveOption(options, "--hashed-registry")),
+  staticMetadata(haveOption(options, "--static-metadata")),
+  threads(intOption(options, "--threads=", 1))
+{
+    if(threads < 1)
+    {
+        threads = 1;
+    }
+}
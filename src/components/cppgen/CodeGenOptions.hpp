@@ -0,0 +1,68 @@
+/**
+ * File    : CodeGenOptions.hpp
+ * Author  : Emir Uner
+ * Summary : Options of a code generation run.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_CPPGEN_CODEGENOPTIONS_HPP_INCLUDED
+#define XCOMIDL_CPPGEN_CODEGENOPTIONS_HPP_INCLUDED
+
+#include <xcom/Types.hpp>
+
+/**
+ * Options that change the generated code or how it is generated.
+ */
+struct CodeGenOptions
+{
+    /**
+     * Read the options from the code generator option strings.
+     */
+    explicit CodeGenOptions(xcom::StringSeq const& options);
+
+    /**
+     * Generate C++11 code, "--cxx11". Adds move operations to
+     * interfaces, structs, sequences and exceptions.
+     */
+    bool cxx11;
+
+    /**
+     * Register metadata through the hashed type index of
+     * xcomidl/TypeRegistry.hpp, "--hashed-registry". The generated
+     * code needs C++11.
+     */
+    bool hashedRegistry;
+
+    /**
+     * Describe interface and struct metadata by constant tables that
+     * are registered through xcomidl/StaticMetadata.hpp,
+     * "--static-metadata". The generated code needs C++11.
+     */
+    bool staticMetadata;
+
+    /**
+     * Number of threads rendering the types, "--threads=N".
+     */
+    int threads;
+};
+
+#endif
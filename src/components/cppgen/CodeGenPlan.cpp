@@ -0,0 +1,82 @@
+/**
+ * File    : CodeGenPlan.cpp
+ * Author  : Emir Uner
+ * Summary : Code generation hints with their types resolved.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "CodeGenPlan.hpp"
+
+#include <xcom/metadata/Exception.hpp>
+#include <xcom/metadata/Interface.hpp>
+
+using namespace xcom::metadata;
+using namespace xcomidl;
+
+CodeGenPlan::CodeGenPlan(Repository const& repo, HintSeq const& hints)
+{
+    HintSeq::const_iterator hint;
+
+    steps_.reserve(hints.size());
+    
+    for(hint = hints.begin(); hint != hints.end(); ++hint)
+    {
+        PlanStep step;
+
+        step.hint = (CodeGenHintEnum)hint->type;
+        step.parameter = hint->parameter.c_str();
+        step.kind = -1;
+
+        if(step.hint == CodeGenHint::NoThrow)
+        {
+            noThrowMethods_.insert(step.parameter);
+            continue;
+        }
+        
+        if(step.hint == CodeGenHint::GenType ||
+           step.hint == CodeGenHint::GenForward)
+        {
+            step.type = repo.findType(step.parameter);
+
+            if(!step.type.isNil())
+            {
+                step.kind = step.type.getKind();
+            }
+        }
+
+        if(step.hint == CodeGenHint::GenType)
+        {
+            types_.push_back(step.type);
+
+            if(step.kind == TypeKind::Interface)
+            {
+                interfaces_.push_back(xcom::cast<IInterface>(step.type));
+            }
+            else if(step.kind == TypeKind::Exception)
+            {
+                exceptions_.push_back(xcom::cast<IException>(step.type));
+            }
+        }
+        
+        steps_.push_back(step);
+    }
+}
@@ -0,0 +1,127 @@
+/**
+ * File    : CodeGenPlan.hpp
+ * Author  : Emir Uner
+ * Summary : Code generation hints with their types resolved.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_CPPGEN_CODEGENPLAN_HPP_INCLUDED
+#define XCOMIDL_CPPGEN_CODEGENPLAN_HPP_INCLUDED
+
+#include <xcomidl/Repository.hpp>
+#include <xcomidl/ParserTypes.hpp>
+
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * Methods named by interface name and method name joined by a dot.
+ */
+typedef std::set<std::string> MethodSet;
+
+/**
+ * A code generation hint. The type named by GenType and GenForward
+ * hints is found beforehand.
+ */
+struct PlanStep
+{
+    xcomidl::CodeGenHintEnum hint;
+    std::string parameter;
+
+    /**
+     * Type named by the parameter, nil for other hints.
+     */
+    xcom::metadata::IType type;
+
+    /**
+     * Kind of the type, -1 if there is no type.
+     */
+    int kind;
+};
+
+/**
+ * The hints of an idl file resolved once against the repository,
+ * used by all code generation passes. Types to generate are also
+ * kept in per kind lists for passes that need only some kinds.
+ * NoThrow hints are not steps, they are collected in a set.
+ */
+class CodeGenPlan
+{
+public:
+    /**
+     * Resolve the hints.
+     */
+    CodeGenPlan(xcomidl::Repository const& repo,
+                xcomidl::HintSeq const& hints);
+
+    /**
+     * All hints in order except NoThrow hints.
+     */
+    inline std::vector<PlanStep> const& getSteps() const
+    {
+        return steps_;
+    }
+
+    /**
+     * Types of GenType hints in order.
+     */
+    inline std::vector<xcom::metadata::IType> const& getTypes() const
+    {
+        return types_;
+    }
+
+    /**
+     * Interfaces of GenType hints in order.
+     */
+    inline std::vector<xcom::metadata::IInterface> const&
+    getInterfaces() const
+    {
+        return interfaces_;
+    }
+
+    /**
+     * Exceptions of GenType hints in order.
+     */
+    inline std::vector<xcom::metadata::IException> const&
+    getExceptions() const
+    {
+        return exceptions_;
+    }
+
+    /**
+     * Methods of NoThrow hints.
+     */
+    inline MethodSet const& getNoThrowMethods() const
+    {
+        return noThrowMethods_;
+    }
+    
+private:
+    std::vector<PlanStep> steps_;
+    std::vector<xcom::metadata::IType> types_;
+    std::vector<xcom::metadata::IInterface> interfaces_;
+    std::vector<xcom::metadata::IException> exceptions_;
+    MethodSet noThrowMethods_;
+};
+
+#endif
@@ -29,22 +29,8 @@
 #include <stdexcept>
 #include <fstream>
 
-#include <xcom/metadata/Enum.hpp>
-#include <xcom/metadata/Array.hpp>
-#include <xcom/metadata/Sequence.hpp>
-#include <xcom/metadata/Struct.hpp>
-#include <xcom/metadata/Exception.hpp>
-#include <xcom/metadata/Interface.hpp>
-
 #include "Helper.hpp"
-#include "EnumGen.hpp"
-#include "StructGen.hpp"
-#include "ExceptionGen.hpp"
-#include "ArrayGen.hpp"
-#include "SequenceGen.hpp"
-#include "InterfaceGen.hpp"
 #include "IndentedOutput.hpp"
-#include "DelegateGen.hpp"
 
 using namespace xcom::metadata;
 using namespace xcomidl;
@@ -52,9 +38,8 @@ using namespace xcomidl;
 namespace
 {
 
-std::string genForward(std::string const& forwarded, Repository& repo)
+std::string genForward(IType const& type)
 {
-    IType type = repo.findType(forwarded);
     IDeclared decl = xcom::cast<IDeclared>(type);
     assert(decl.isNil() == false);
     if(type.getKind() == TypeKind::Interface)
@@ -69,31 +54,6 @@ std::string genForward(std::string const& forwarded, Repository& repo)
     }
 }
 
-std::string genType(IType type, RuleBase& rules)
-{
-    switch(type.getKind())
-    {
-    case TypeKind::Enum:
-        return EnumGen(xcom::cast<IEnum>(type)).genType();
-    case TypeKind::Array:
-        return ArrayGen(xcom::cast<IArray>(type), rules).genType();
-    case TypeKind::Sequence:
-        return SequenceGen(xcom::cast<ISequence>(type), rules).genType();
-    case TypeKind::Struct:
-        return StructGen(xcom::cast<IStruct>(type), rules).genType();
-    case TypeKind::Exception:
-        return ExceptionGen(xcom::cast<IException>(type), rules).genType();
-    case TypeKind::Interface:
-        return InterfaceGen(xcom::cast<IInterface>(type), rules).genType();
-    case TypeKind::Delegate:
-        return DelegateGen(xcom::cast<IDelegate>(type), rules).genType();
-    default:
-        assert(false);
-    }
-
-    return "";
-}
-
 std::string replaceIdl(std::string src)
 {
     std::string::size_type idlpos = src.rfind(".idl");
@@ -108,25 +68,23 @@ std::string replaceIdl(std::string src)
     return src;
 }
 
-void genTypes(Repository& repo, HintSeq const& hints, IndentedOutput& out,
-              RuleBase& rules)
+void genTypes(CodeGenPlan const& plan, Fragments const& fragments,
+              IndentedOutput& out)
 {
-    HintSeq::const_iterator hint;
+    std::vector<PlanStep>::const_iterator step;
 
-    for(hint = hints.begin(); hint != hints.end(); ++hint)
+    for(step = plan.getSteps().begin(); step != plan.getSteps().end(); ++step)
     {
-        switch(hint->type)
+        switch(step->hint)
         {
         case CodeGenHint::GenImport:
-            out.writeLine("#include <" +
-                          replaceIdl(hint->parameter.c_str()) + '>');
+            out.writeLine("#include <" + replaceIdl(step->parameter) + '>');
             break;
         case CodeGenHint::GenForward:
-            out.writeLine(genForward(hint->parameter.c_str(), repo));
+            out.writeLine(genForward(step->type));
             break;
         case CodeGenHint::EnterNamespace:
-            out.writeLine("namespace " +
-                          std::string(hint->parameter.c_str()) + "\n{");
+            out.writeLine("namespace " + step->parameter + "\n{");
             ++out;
             break;
         case CodeGenHint::LeaveNamespace:
@@ -134,26 +92,23 @@ void genTypes(Repository& repo, HintSeq const& hints, IndentedOutput& out,
             out.writeLine("}");
             break;
         case CodeGenHint::GenType:
-            out.writeLine(genType(repo.findType(
-                                      hint->parameter.c_str()), rules));
+            out.writeLine(fragments[step - plan.getSteps().begin()].type);
             break;
         }
     }    
 }
 
-void genItfMethods(Repository& repo, HintSeq const& hints,
-                   IndentedOutput& out, RuleBase& rules)
+void genItfMethods(CodeGenPlan const& plan, Fragments const& fragments,
+                   IndentedOutput& out)
 {
-    HintSeq::const_iterator hint;
-    IType type;
+    std::vector<PlanStep>::const_iterator step;
 
-    for(hint = hints.begin(); hint != hints.end(); ++hint)
+    for(step = plan.getSteps().begin(); step != plan.getSteps().end(); ++step)
     {
-        switch(hint->type)
+        switch(step->hint)
         {
         case CodeGenHint::EnterNamespace:
-            out.writeLine("namespace " +
-                          std::string(hint->parameter.c_str()) + "\n{");
+            out.writeLine("namespace " + step->parameter + "\n{");
             ++out;
             break;
         case CodeGenHint::LeaveNamespace:
@@ -161,79 +116,52 @@ void genItfMethods(Repository& repo, HintSeq const& hints,
             out.writeLine("}");
             break;
         case CodeGenHint::GenType:
-            type = repo.findType(hint->parameter.c_str());
-            if(!type.isNil() && type.getKind() == TypeKind::Interface)
+            if(step->kind == TypeKind::Interface)
             {
                 out.writeLine(
-                    InterfaceGen(xcom::cast<IInterface>(type), rules).
-                        genMethods());
+                    fragments[step - plan.getSteps().begin()].methods);
             }
             break;
+        default:
+            break;
         }
     }    
 }
 
-std::string genMetadata(IType type, RuleBase& rules)
-{
-    switch(type.getKind())
-    {
-    case TypeKind::Enum:
-        return EnumGen(xcom::cast<IEnum>(type)).genMetadata();
-        break;
-    case TypeKind::Array:
-        return ArrayGen(xcom::cast<IArray>(type), rules).genMetadata();
-        break;
-    case TypeKind::Sequence:
-        return SequenceGen(xcom::cast<ISequence>(type), rules).genMetadata();
-        break;
-    case TypeKind::Struct:
-        return StructGen(xcom::cast<IStruct>(type), rules).genMetadata();
-        break;
-    case TypeKind::Exception:
-        return ExceptionGen(xcom::cast<IException>(type), rules).genMetadata();
-        break;
-    case TypeKind::Interface:
-        return InterfaceGen(xcom::cast<IInterface>(type),rules).genMetadata();
-        break;
-    case TypeKind::Delegate:
-        return DelegateGen(xcom::cast<IDelegate>(type), rules).genMetadata();
-
-    default:
-        assert(false);
-    }
-
-    return "";
-}
-
-void genMetadatas(Repository& repo, HintSeq const& hints, IndentedOutput& out,
-                  RuleBase& rules)
+void genMetadatas(CodeGenPlan const& plan, CodeGenOptions const& options,
+                  Fragments const& fragments, IndentedOutput& out)
 {
-    HintSeq::const_iterator hint;
+    std::vector<PlanStep> const& steps = plan.getSteps();
+    std::vector<PlanStep>::size_type i;
 
     out.writeLine("#include <xcom/MDHelper.hpp>");
+
+    if(options.staticMetadata)
+    {
+        out.writeLine("#include <xcomidl/StaticMetadata.hpp>");
+    }
+    else if(options.hashedRegistry)
+    {
+        out.writeLine("#include <xcomidl/TypeRegistry.hpp>");
+    }
+    
     out.writeLine("namespace xcom\n{\n");
     ++out;
 
-    for(hint = hints.begin(); hint != hints.end(); ++ hint)
+    for(i = 0; i < steps.size(); ++i)
     {
-        if(hint->type == CodeGenHint::GenType)
+        if(steps[i].hint == CodeGenHint::GenType &&
+           steps[i].kind == TypeKind::Interface)
         {
-            IType type = repo.findType(hint->parameter.c_str());
-            if(!type.isNil() && type.getKind() == TypeKind::Interface)
-            {
-                out.writeLine(
-                    InterfaceGen(xcom::cast<IInterface>(type), rules).
-                        genMetadataForward());
-            }
+            out.writeLine(fragments[i].metadataForward);
         }
     }
     
-    for(hint = hints.begin(); hint != hints.end(); ++hint)
+    for(i = 0; i < steps.size(); ++i)
     {
-        if(hint->type == CodeGenHint::GenType)
+        if(steps[i].hint == CodeGenHint::GenType)
         {
-            out.writeLine(genMetadata(repo.findType(hint->parameter.c_str()),
-                                      rules));
+            out.writeLine(fragments[i].metadata);
         }
     }    
 
@@ -241,51 +169,45 @@ void genMetadatas(Repository& repo, HintSeq const& hints, IndentedOutput& out,
     out.writeLine("} // namespace xcom\n");
 }
 
-void genExceptionMethods(Repository& repo, HintSeq const& hints,
-                         IndentedOutput& out, RuleBase& rules)
+void genExceptionMethods(CodeGenPlan const& plan, Fragments const& fragments,
+                         IndentedOutput& out)
 {
-    const int hintCount = (int)hints.size();
+    std::vector<PlanStep>::const_iterator step;
 
-    for(int i = 0; i < hintCount; ++i)
+    for(step = plan.getSteps().begin(); step != plan.getSteps().end(); ++step)
     {
-        if(hints[i].type == CodeGenHint::EnterNamespace)
+        if(step->hint == CodeGenHint::EnterNamespace)
         {
-            out.writeLine(std::string("namespace ") +
-                          hints[i].parameter.c_str() + "\n{\n");
+            out.writeLine("namespace " + step->parameter + "\n{\n");
             ++out;
         }
-        else if(hints[i].type == CodeGenHint::LeaveNamespace)
+        else if(step->hint == CodeGenHint::LeaveNamespace)
         {
             --out;
             out.writeLine("}\n");
         }
-        else if(hints[i].type == CodeGenHint::GenType)
+        else if(step->hint == CodeGenHint::GenType &&
+                step->kind == TypeKind::Exception)
         {
-            IType type(repo.findType(hints[i].parameter.c_str()));
-            
-            if(type.getKind() == TypeKind::Exception)
-            {
-                ExceptionGen gen(xcom::cast<IException>(type), rules);
-                out.writeLine(gen.genMethods());
-            }
+            out.writeLine(
+                fragments[step - plan.getSteps().begin()].exceptionMethods);
         }
     }
 }
 
 } // namespace <unnamed>
 
-void genCommonHeader(Repository& repo, HintSeq const& hints,
-                     std::ostream& os)
+void genCommonHeader(CodeGenPlan const& plan, CodeGenOptions const& options,
+                     Fragments const& fragments, std::string& output)
 {
-    IndentedOutput out(os, 4);
-    RuleBase rules;
+    IndentedOutput out(output, 4);
     
     out.writeLine("\n#include <xcom/Types.hpp>\n");
 
-    genTypes(repo, hints, out, rules);
-    genItfMethods(repo, hints, out, rules);
-    genMetadatas(repo, hints, out, rules);
+    genTypes(plan, fragments, out);
+    genItfMethods(plan, fragments, out);
+    genMetadatas(plan, options, fragments, out);
     out.writeLine("#include <xcom/ExcHelper.hpp>\n");
-    genExceptionMethods(repo, hints, out, rules);
+    genExceptionMethods(plan, fragments, out);
     //genClasses(repo, hints, out, rules);
 }
@@ -27,14 +27,16 @@
 #ifndef XCOMIDL_CPPGEN_COMMONHEADERGEN_HPP_INCLUDED
 #define XCOMIDL_CPPGEN_COMMONHEADERGEN_HPP_INCLUDED
 
-#include <xcomidl/Repository.hpp>
-#include <xcomidl/ParserTypes.hpp>
+#include "CodeGenPlan.hpp"
+#include "Fragments.hpp"
+
+#include <string>
 
 /**
- * Generate client/implementor common header file.
+ * Generate client/implementor common header file from the rendered
+ * fragments of the plan. The header text is appended to output.
  */
-void genCommonHeader(xcomidl::Repository& repo,
-                     xcomidl::HintSeq const& hints,
-                     std::ostream& output);
+void genCommonHeader(CodeGenPlan const& plan, CodeGenOptions const& options,
+                     Fragments const& fragments, std::string& output);
 
 #endif
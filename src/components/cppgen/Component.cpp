@@ -28,42 +28,34 @@
 #include <xcom/ImplHelper.hpp>
 #include <xcomidl/ParserTypesTie.hpp>
 #include <xcomidl/Repository.hpp>
+#include <xcomidl/Hash.hpp>
 #include <xcom/Portability.hpp>
 
 #include "CommonHeaderGen.hpp"
 #include "TieHeaderGen.hpp"
 #include "Helper.hpp"
+#include "OutputFile.hpp"
 
-#include <fstream>
 #include <algorithm>
+#include <stdio.h>
 
 namespace
 {
 
 /**
- * Creates a unique string that is suitable to be used as a
- * header guard in the form uppercase_filename_included_guid_with_underscores
+ * Creates a header guard in the form
+ * INC_UPPERCASE_FILENAME_CONTENTHASH from the name of the header and
+ * the text it guards. The same header always gets the same guard while
+ * headers with the same name but different contents do not clash.
  */
-std::string genHeaderGuard(std::string filename)
+std::string genHeaderGuard(std::string filename, std::string const& content)
 {
-    char guidStr[37];
+    char hashStr[17];
     unsigned int i;
     
-    xcom::GUID guid;
-    xcomGenerateGUID(&guid);
-    xcomGUIDToString(&guid, guidStr);
-
-    for(i = 0; i < 36; ++i)
-    {
-        if(guidStr[i] == '-')
-        {
-            guidStr[i] = '_';
-        }
-        else
-        {
-            guidStr[i] = toupper(guidStr[i]);
-        }
-    }
+    sprintf(hashStr, "%016llX",
+            xcomidl::contentHash(content.data(),
+                                 content.data() + content.size()));
     
     for(i = 0; i < filename.size(); ++i)
     {
@@ -77,7 +69,7 @@ std::string genHeaderGuard(std::string filename)
         }
     }
     
-    return "INC_" + filename + "_" + guidStr;
+    return "INC_" + filename + "_" + hashStr;
 }
 
 bool haveOption(xcom::StringSeq const & options, xcom::String const & opt, xcom::String const & alt)
@@ -85,7 +77,7 @@ bool haveOption(xcom::StringSeq const & options, xcom::String const & opt, xcom:
     return std::find(options.begin(), options.end(), opt) != options.end() || 
         std::find(options.begin(), options.end(), alt) != options.end();
 }
-    
+
 std::string stripPath(std::string const& path)
 {
     std::string::size_type lastDivPos = path.rfind('/');
@@ -98,51 +90,94 @@ std::string stripPath(std::string const& path)
     return std::string(path.begin() + path.rfind('/') + 1, path.end());
 }
 
-xcom::String openFile(std::ofstream& os, xcom::String const &idlname, const char* suffix)
+/**
+ * Name of the header generated for the idl file.
+ */
+std::string headerName(xcom::String const &idlname, const char* suffix)
 {
-    std::string filename(split(stripPath(std::string(idlname.c_str())), ".")[0] + suffix);
-    os.open(filename.c_str());
-
-//    if(!os.is_open())
-//        throw runtime_error("Cannot open file " + filename + " for writing.");
+    return split(stripPath(std::string(idlname.c_str())), ".")[0] + suffix;
+}
 
-    std::string guard(genHeaderGuard(filename));
-    os << "#ifndef " << guard << std::endl;
-    os << "#define " << guard << std::endl;
+/**
+ * Wraps the generated text with a header guard.
+ */
+std::string guardHeader(std::string const& filename, std::string const& body)
+{
+    std::string guard(genHeaderGuard(filename, body));
 
-    return filename.c_str();
+    return "#ifndef " + guard + "\n#define " + guard + "\n" + body +
+        "#endif\n";
 }
-
-void closeFile(std::ofstream& os)
+    
+/**
+ * Render the headers of the idl file. The names and contents of the
+ * headers are added to the given sequences in the same order.
+ */
+void renderHeaders(xcomidl::TypeSeq const& types, xcomidl::HintSeq const& hints,
+                   xcom::String const& idlname, xcom::StringSeq const& options,
+                   std::vector<std::string>& names,
+                   std::vector<std::string>& contents)
 {
-    os << "#endif" << std::endl;
-    os.close();
+    xcomidl::Repository repo(types);
+    CodeGenPlan plan(repo, hints);
+    CodeGenOptions genOptions(options);
+    Fragments fragments;
+    std::string output;
+
+    renderFragments(plan, genOptions, fragments);
+
+    if(haveOption(options, "-s", "--single-header"))
+    {
+        std::string fname(headerName(idlname, ".hpp"));
+        genCommonHeader(plan, genOptions, fragments, output);
+        genTieHeader(plan, fragments, output);
+        names.push_back(fname);
+        contents.push_back(guardHeader(fname, output));
+    }
+    else
+    {
+        std::string fname(headerName(idlname, ".hpp"));
+        genCommonHeader(plan, genOptions, fragments, output);
+        names.push_back(fname);
+        contents.push_back(guardHeader(fname, output));
+
+        std::string tieName(headerName(idlname, "Tie.hpp"));
+        output = "\n#include \"" + fname + "\"\n";
+        genTieHeader(plan, fragments, output);
+        names.push_back(tieName);
+        contents.push_back(guardHeader(tieName, output));
+    }
 }
 
-struct CppGen : public xcom::Supports<CppGen, xcomidl::ICodeGen>, public xcom::RefCounted<CppGen>
+struct CppGen : public xcom::Supports<CppGen, xcomidl::ICodeGen2>, public xcom::RefCounted<CppGen>
 {
     void generate(xcomidl::TypeSeq const& types, xcomidl::HintSeq const& hints, xcom::String const& idlname, 
                   xcom::StringSeq const& options)
     {
-        xcomidl::Repository repo(types);
-        std::ofstream os;
+        std::vector<std::string> names, contents;
+
+        renderHeaders(types, hints, idlname, options, names, contents);
 
-        if(haveOption(options, "-s", "--single-header"))
+        for(std::vector<std::string>::size_type i = 0; i < names.size(); ++i)
         {
-            openFile(os, idlname, ".hpp");
-            genCommonHeader(repo, hints, os);
-            genTieHeader(repo, hints, os);
-            closeFile(os);
+            writeOutput(names[i], contents[i]);
         }
-        else
+    }
+
+    void generateToBuffers(xcomidl::TypeSeq const& types, xcomidl::HintSeq const& hints,
+                           xcom::String const& idlname, xcom::StringSeq const& options,
+                           xcom::StringSeq& names, xcom::StringSeq& contents)
+    {
+        std::vector<std::string> headerNames, headerContents;
+
+        renderHeaders(types, hints, idlname, options, headerNames, headerContents);
+
+        names.clear();
+        contents.clear();
+        for(std::vector<std::string>::size_type i = 0; i < headerNames.size(); ++i)
         {
-            xcom::String fname = openFile(os, idlname, ".hpp");
-            genCommonHeader(repo, hints, os);
-            closeFile(os);
-            openFile(os, idlname, "Tie.hpp");
-            os << "\n#include \"" << fname << "\"\n";
-            genTieHeader(repo, hints, os);
-            closeFile(os);
+            names.push_back(headerNames[i].c_str());
+            contents.push_back(headerContents[i].c_str());
         }
     }
 };
@@ -156,11 +191,12 @@ struct DLLAccess : public xcom::DLLAccessBase
         classes.push_back("xcomidl.CppGen");
 
         // Register only interfaces
-        xcom::TypeDesc<xcomidl::ICodeGen>::addSelf(types);
+        xcom::TypeDesc<xcomidl::ICodeGen2>::addSelf(types);
         
         // Add metadata of interfaces that may be returned from QI
         addInterface("xcom.IUnknown");
         addInterface("xcomidl.ICodeGen");
+        addInterface("xcomidl.ICodeGen2");
     }
     
     xcom::IUnknown dllCreateObject(const xcom::Char* classname)
@@ -34,7 +34,8 @@ using namespace xcom::metadata;
 namespace
 {
 
-char const* voidDelegateTmpl =
+TextTmpl::Source voidDelegateTmpl =
+{
 "struct @name@: public ::xcom::Delegate\n"
 "{\t\n"
     "typedef void (*RawFunctionType)(void*, ::xcom::Environment*@params@);\n"
@@ -49,9 +50,11 @@ char const* voidDelegateTmpl =
         "((RawFunctionType)function)(context, &__env@params@);\n"
         "if(__env.exception) ::xcomFindAndThrow(&__env);\v\n"
     "}\v\n"
-"};\n";
+"};\n"
+};
 
-char const* delegateTmpl =
+TextTmpl::Source delegateTmpl =
+{
 "struct @name@: public ::xcom::Delegate\n"
 "{\t\n"
     "typedef @rettype@ (*RawFunctionType)(void*, ::xcom::Environment*@params@);\n"
@@ -67,7 +70,8 @@ char const* delegateTmpl =
         "if(__env.exception) ::xcomFindAndThrow(&__env);\n"
         "return result;\v\n"
     "}\v\n"
-"};\n";
+"};\n"
+};
 
 std::string genRawParamDecls(const IDelegate& del, RuleBase& rules)
 {
@@ -128,7 +132,8 @@ std::string genFwdParams(const IDelegate& del, RuleBase& rules)
     return result;
 }
 
-static const char* staticForwarderTmpl =
+static TextTmpl::Source staticForwarderTmpl =
+{
 "static @rawret@ static_caller(void* __ctx, ::xcom::Environment* __env@rawparams@)\n"
 "{\t\n"
     "try { @isreturn@((FunctionType)__ctx)(@params@)@isdetach@; }\n"
@@ -141,7 +146,8 @@ static const char* staticForwarderTmpl =
     "function = (Delegate::FunctionType)static_caller;\n"
     "u.fp = fn;\n"
     "context = u.vp;\v\n"
-"}\n";
+"}\n"
+};
 
 std::string genStaticForwarder(const IDelegate& del,
                                const std::string& basename,
@@ -173,7 +179,8 @@ std::string genStaticForwarder(const IDelegate& del,
     return tmpl();
 }
 
-static const char* functorForwarderTmpl =
+static TextTmpl::Source functorForwarderTmpl =
+{
 "template<typename Functor>\n"
 "struct functor_caller {\t\n"
     "static @rawret@ call(void* __ctx, ::xcom::Environment* __env@rawparams@)\n"
@@ -188,7 +195,8 @@ static const char* functorForwarderTmpl =
 "{\t\n"
     "function = (Delegate::FunctionType)functor_caller<Functor>::call;\n"
     "context = &fn;\v\n"
-"}\n";
+"}\n"
+};
 
 std::string genFunctorForwarder(const IDelegate& del,
                                 const std::string& basename,
@@ -220,7 +228,8 @@ std::string genFunctorForwarder(const IDelegate& del,
     return tmpl();
 }
 
-static const char* memberForwarderTmpl =
+static TextTmpl::Source memberForwarderTmpl =
+{
 "template<typename Object>\n"
 "struct object_caller {\t\n"
     "typedef xcom::MemberBinder<Object,\t\n"
@@ -241,7 +250,8 @@ static const char* memberForwarderTmpl =
     "static ::std::set<Binder> s;\n"
     "context = &(*s.insert(b).first);\n"
     "function = (Delegate::FunctionType)object_caller<Object>::call;\v\n"
-"}\n";
+"}\n"
+};
 
 std::string genMemberForwarder(const IDelegate& del,
                                const std::string& basename,
@@ -277,22 +287,29 @@ std::string genMemberForwarder(const IDelegate& del,
     return tmpl();
 }
 
-char const* assignNameTmpl =
-"pnames[@paramIndex@] = \"@paramName@\";\n";
+TextTmpl::Source assignNameTmpl =
+{
+"pnames[@paramIndex@] = \"@paramName@\";\n"
+};
 
-char const* assignTypeTmpl =
-"ptypes[@paramIndex@] = @findType@;\n";
+TextTmpl::Source assignTypeTmpl =
+{
+"ptypes[@paramIndex@] = @findType@;\n"
+};
 
-char const* assignModeTmpl =
-"pmodes[@paramIndex@] = @paramMode@;\n";
+TextTmpl::Source assignModeTmpl =
+{
+"pmodes[@paramIndex@] = @paramMode@;\n"
+};
 
-const char* delegateTypeDesc = 
+TextTmpl::Source delegateTypeDesc =
+{
 "template <>\n"
 "struct TypeDesc<@name@>\n"
 "{\t\n"
     "static void addSelf(IUnknownSeq& types)\n"
     "{\t\n"
-        "if(!typeExists(types, \"@name@\"))\n"
+        "if(!@typeExists@)\n"
         "{\t\n"
             "Char const* pnames[@count@];\n"
             "IUnknownRaw* ptypes[@count@];\n"
@@ -302,14 +319,17 @@ const char* delegateTypeDesc =
                     "@paramCount@, pmodes, ptypes, pnames));\n"
         "}\v\n"
     "}\v\n"
-"};\n";
+"};\n"
+};
 
-char const* fillTmpl =
+TextTmpl::Source fillTmpl =
+{
 "@names@\n"
 "@types@\n"
-"@modes@\n";
+"@modes@\n"
+};
 
-std::string genFills(IDelegate const& del)
+std::string genFills(IDelegate const& del, CodeGenOptions const& options)
 {
     std::string names, types, modes;
     const ParamInfoSeq params(del.getParameters());
@@ -319,17 +339,20 @@ std::string genFills(IDelegate const& del)
     {
         const std::string paramIndex(intToStr(i-1));
         
-        names += TextTmpl(assignNameTmpl, 4)
+        TextTmpl(assignNameTmpl, 4)
             .addParam(paramIndex)
-            .addParam(params[i].name.c_str())();
+            .addParam(params[i].name.c_str())
+            .expand(names);
 
-        types += TextTmpl(assignTypeTmpl, 4)
+        TextTmpl(assignTypeTmpl, 4)
             .addParam(paramIndex)
-            .addParam(genRawFind(params[i].type))();
+            .addParam(genRawFind(params[i].type, options))
+            .expand(types);
 
-        modes += TextTmpl(assignModeTmpl, 4).
-            addParam(paramIndex).
-            addParam(intToStr(params[i].mode))();
+        TextTmpl(assignModeTmpl, 4)
+            .addParam(paramIndex)
+            .addParam(intToStr(params[i].mode))
+            .expand(modes);
     }
     
     return TextTmpl(fillTmpl, 4)
@@ -391,8 +414,10 @@ std::string genDelegate(IDelegate& type, const std::string& basename,
 
 } // namespace  <unnamed>
 
-DelegateGen::DelegateGen(const IDelegate& delegateType, RuleBase& rules)
-: type_(delegateType), rules_(rules), basename_(basePart(type_.getName().c_str()))
+DelegateGen::DelegateGen(const IDelegate& delegateType, RuleBase& rules,
+                         CodeGenOptions const& options)
+: type_(delegateType), rules_(rules), options_(options),
+  basename_(basePart(type_.getName().c_str()))
 {
 }
 
@@ -412,13 +437,13 @@ std::string DelegateGen::genMetadata()
     const std::string count(intToStr(type_.getParameters().size()));
     
     tmpl.addParam(scopedName(type_.getName().c_str()));
-    tmpl.addParam(type_.getName().c_str());
+    tmpl.addParam(genTypeExists(type_.getName().c_str(), options_));
     tmpl.addParam(count);
     tmpl.addParam(count);
     tmpl.addParam(count);
-    tmpl.addParam(genFills(type_));
+    tmpl.addParam(genFills(type_, options_));
     tmpl.addParam(scopedName(type_.getName().c_str()));
-    tmpl.addParam(genRawFind(type_.getParameters()[0].type));
+    tmpl.addParam(genRawFind(type_.getParameters()[0].type, options_));
     tmpl.addParam(intToStr(type_.getParameters().size() - 1));
     
     return tmpl();
@@ -29,6 +29,7 @@
 
 #include <xcom/metadata/Delegate.hpp>
 #include "RuleBase.hpp"
+#include "CodeGenOptions.hpp"
 
 /**
  * Code generator for delegates.
@@ -40,7 +41,8 @@ public:
      * A code generator for given structure using the given rule base
      * for members.
      */
-    DelegateGen(xcom::metadata::IDelegate const& delegateType, RuleBase& rules);
+    DelegateGen(xcom::metadata::IDelegate const& delegateType, RuleBase& rules,
+                CodeGenOptions const& options);
 
     /**
      * Generate struct definition.
@@ -60,6 +62,7 @@ public:
 private:
     xcom::metadata::IDelegate type_;
     RuleBase& rules_;
+    CodeGenOptions const& options_;
     const std::string basename_;
 };
 
@@ -34,7 +34,8 @@ using namespace xcom::metadata;
 namespace
 {
 
-char const* enumTmpl =
+TextTmpl::Source enumTmpl =
+{
 "namespace @enumName@\n"
 "{\t\n"
     "enum type\n"
@@ -42,22 +43,25 @@ char const* enumTmpl =
         "@elements@\v\n"
     "};\v\n"
 "}\n"
-"typedef @enumName@::type @enumName@Enum;\n";
+"typedef @enumName@::type @enumName@Enum;\n"
+};
 
-char const* metadataTmpl =
+TextTmpl::Source metadataTmpl =
+{
 "template <>\n"
 "struct TypeDesc<@enumName@Enum>\n"
 "{\t\n"
     "static void addSelf(IUnknownSeq& types)\n"
     "{\t\n"
-        "if(!typeExists(types, \"@enumName@\"))\n"
+        "if(!@typeExists@)\n"
         "{\t\n"
             "static Char const* elements[@count@] = { @elementList@ };\n"
             "addType(types, xcomCreateEnumMD(\"@enumName@\", elements, "
                                              "@count@));\v\n"
         "}\v\n"
     "}\v\n"
-"};";
+"};"
+};
 
 inline std::string genElementList(IEnum const& type)
 {
@@ -76,8 +80,8 @@ inline std::string genElementList(IEnum const& type)
 
 } // namespace <unnamed>
 
-EnumGen::EnumGen(IEnum const& ie)
-: type_(ie)
+EnumGen::EnumGen(IEnum const& ie, CodeGenOptions const& options)
+: type_(ie), options_(options)
 {
 }
 
@@ -106,7 +110,7 @@ std::string EnumGen::genMetadata()
     TextTmpl tmpl(metadataTmpl, 4);
     
     tmpl.addParam(scopedName(type_.getName().c_str()));
-    tmpl.addParam(type_.getName().c_str());
+    tmpl.addParam(genTypeExists(type_.getName().c_str(), options_));
     
     tmpl.addParam(intToStr(type_.getElementCount()));
     tmpl.addParam(genElementList(type_));
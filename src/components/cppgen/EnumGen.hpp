@@ -27,6 +27,7 @@
 #define XCOM_TOOLS_IDLTOCPP_ENUMGEN_HPP_INCLUDED
 
 #include <xcom/metadata/Enum.hpp>
+#include "CodeGenOptions.hpp"
 
 /**
  * Code generator for enum's
@@ -34,7 +35,8 @@
 class EnumGen
 {
 public:
-    EnumGen(xcom::metadata::IEnum const& enumType);
+    EnumGen(xcom::metadata::IEnum const& enumType,
+            CodeGenOptions const& options);
 
     /**
      * Get the code generated for this enum.
@@ -48,6 +50,7 @@ public:
     
 private:
     xcom::metadata::IEnum type_;
+    CodeGenOptions const& options_;
 };
 
 #endif
@@ -104,13 +104,15 @@ std::string genMembers(IException const& exc, RuleBase& rules)
     return result;
 }
     
-char const* adoptTmpl =
+TextTmpl::Source adoptTmpl =
+{
 "static @excname@ adopt(RawType const& raw)\n"
 "{\t\n"
     "@excname@ result;\n"
     "::memcpy(&result, &raw, sizeof(RawType));\n"
     "return result;\v\n"
-"}\n";
+"}\n"
+};
 
 std::string genAdopt(IException const& exc)
 {
@@ -122,10 +124,13 @@ std::string genAdopt(IException const& exc)
     return tmpl();
 }
 
-char const* detachLineTmpl =
-"result.@memberName@ = @srcMemberName@@detachCall@;";
+TextTmpl::Source detachLineTmpl =
+{
+"result.@memberName@ = @srcMemberName@@detachCall@;"
+};
 
-char const* detachTmpl =
+TextTmpl::Source detachTmpl =
+{
 "RawType detach()\n"
 "{\t\n"
     "RawType result;\n"
@@ -133,7 +138,8 @@ char const* detachTmpl =
     "@assignments@\n"
     "\n"
     "return result;\v\n"
-"};\n";
+"};\n"
+};
 
 std::string genDetachAssignments(IException const& exc, RuleBase& rules)
 {
@@ -161,7 +167,8 @@ std::string genDetachAssignments(IException const& exc, RuleBase& rules)
             assignment.skipParam();
         }
         
-        result += assignment() + '\n';
+        assignment.expand(result);
+        result += '\n';
     }
     
     return result;
@@ -172,14 +179,16 @@ std::string genDetach(IException const& exc, RuleBase& rules)
     return TextTmpl(detachTmpl, 4).addParam(genDetachAssignments(exc,rules))();
 }
 
-char const* exceptionDataTmpl =
+TextTmpl::Source exceptionDataTmpl =
+{
 "struct @excname@@baseexc@\n"
 "{\t\n"
     "@members@\n"
     "typedef @excname@RawData RawType;\n"
     "@detach@\n"
     "@adopt@\v\n"
-"};\n";
+"};\n"
+};
     
 std::string genExceptionData(IException const& exc, RuleBase& rules)
 {
@@ -202,11 +211,13 @@ std::string genExceptionData(IException const& exc, RuleBase& rules)
     return tmpl();
 }
     
-char const* rawExceptionTmpl =
+TextTmpl::Source rawExceptionTmpl =
+{
 "struct @excname@\n"
 "{\t\n"
     "@members@\v\n"
-"};\n";
+"};\n"
+};
 
 std::string genRawMembers(IException const& exc, RuleBase& rules)
 {
@@ -240,16 +251,20 @@ std::string genRawException(IException const& exc, std::string const& name,
     return tmpl();
 }
 
-char const* addElementTmpl =
+TextTmpl::Source addElementTmpl =
+{
 "@addElementType@\n"
 "moffsets.push_back(offsetof(@rawTypeName@, @memberName@));\n"
-"mnames.push_back(\"@name@\");\n\n";
+"mnames.push_back(\"@name@\");\n\n"
+};
 
-char const* mdNamesTmpl =
+TextTmpl::Source mdNamesTmpl =
+{
 "static const Char* mnames[@count@] =\n"
 "{\t\n"
     "@names@\v\n"
-"};\n";
+"};\n"
+};
 
 std::string genMDNames(IException const& type)
 {
@@ -269,13 +284,15 @@ std::string genMDNames(IException const& type)
         .addParam(result)();
 }
 
-char const* offsetOfTmpl = "offsetof(@rawTypeName@, @memberName@),\n";
+TextTmpl::Source offsetOfTmpl = { "offsetof(@rawTypeName@, @memberName@),\n" };
 
-char const* mdOffsetsTmpl =
+TextTmpl::Source mdOffsetsTmpl =
+{
 "static Int moffsets[@count@] =\n"
 "{\t\n"
     "@offsets@\v\n"
-"};\n";
+"};\n"
+};
 
 std::string genMDOffsets(IException const& type, char const* rawName)
 {
@@ -284,9 +301,10 @@ std::string genMDOffsets(IException const& type, char const* rawName)
 
     for(int i = 0; i < count; ++i)
     {
-        result += TextTmpl(offsetOfTmpl, 4)
+        TextTmpl(offsetOfTmpl, 4)
             .addParam(rawName)
-            .addParam(type.getMemberName(i).c_str())();
+            .addParam(type.getMemberName(i).c_str())
+            .expand(result);
     }
     
     return TextTmpl(mdOffsetsTmpl, 4)
@@ -294,20 +312,22 @@ std::string genMDOffsets(IException const& type, char const* rawName)
         .addParam(result)();
 }
 
-char const* mdTypesTmpl =
+TextTmpl::Source mdTypesTmpl =
+{
 "IUnknownRaw* mtypes[@count@] =\n"
 "{\t\n"
     "@types@\v\n"
-"};\n";
+"};\n"
+};
 
-std::string genMDTypes(IException const& type)
+std::string genMDTypes(IException const& type, CodeGenOptions const& options)
 {
     const int count = type.getMemberCount();
     std::string result;
     
     for(int i = 0; i < count; ++i)
     {
-        result += genRawFind(type.getMemberType(i));
+        result += genRawFind(type.getMemberType(i), options);
         result += ",\n";
     }
     
@@ -316,14 +336,15 @@ std::string genMDTypes(IException const& type)
         .addParam(result)();
 }
 
-char const* metadataTmpl =
+TextTmpl::Source metadataTmpl =
+{
 "template <>\n"
 "struct TypeDesc<@scopedName@>\n"
 "{\t\n"
     "static char const* getName() { return \"@idlName@\"; }\n\n"
     "static void addSelf(IUnknownSeq& types)\n"
     "{\t\n"
-        "if(!typeExists(types, \"@scopedIdlName@\"))\n"
+        "if(!@typeExists@)\n"
         "{\t\n"
             "@mtypes@\n"
             "@mnames@\n"
@@ -334,9 +355,10 @@ char const* metadataTmpl =
                                "mtypes, mnames, moffsets));\v\n"
         "}\v\n"
     "}\v\n"
-"};\n";    
+"};\n"
+};    
 
-std::string genMDBase(IException const& exc, RuleBase& rules)
+std::string genMDBase(IException const& exc, CodeGenOptions const& options)
 {
     IException base(exc.getBase());
     
@@ -345,7 +367,7 @@ std::string genMDBase(IException const& exc, RuleBase& rules)
         return "xcom::IUnknownRaw* base = 0;\n";
     }
     
-    return "xcom::IUnknownRaw* base = " + genRawFind(base) + ";\n";
+    return "xcom::IUnknownRaw* base = " + genRawFind(base, options) + ";\n";
 }
 
 int calculateLevel(IException const& exc)
@@ -360,7 +382,67 @@ int calculateLevel(IException const& exc)
     return calculateLevel(base) + 1;
 }
 
-char const* exceptionTmpl =
+/**
+ * Moves take over the data of an exception of the same level. Only a
+ * move from a more derived exception copies the data of this level,
+ * as the copy constructor does.
+ */
+TextTmpl::Source moveTmpl =
+{
+"@excname@(@excname@&& other) noexcept\n"
+"@basecopy@"
+"{\t\n"
+    "takeData(other);\v\n"
+"}\n"
+"\n"
+"@excname@& operator=(@excname@ const&) = default;\n"
+"\n"
+"@excname@& operator=(@excname@&& other) noexcept\n"
+"{\t\n"
+    "if(this != &other)\n"
+    "{\t\n"
+        "if(level == @level@ && metadata != 0)\n"
+        "{\t\n"
+            "data().~@excname@Data();\n"
+            "xcom::IUnknown(static_cast<xcom::IUnknownRaw*>(metadata));\n"
+            "xcomMemFree(excdata);\v\n"
+        "}\n"
+        "\n"
+        "takeData(other);\v\n"
+    "}\n"
+    "\n"
+    "return *this;\v\n"
+"}\n"
+"\n"
+"void takeData(@excname@& other) noexcept\n"
+"{\t\n"
+    "level = @level@;\n"
+    "\n"
+    "if(other.level == @level@)\n"
+    "{\t\n"
+        "metadata = other.metadata;\n"
+        "excdata = other.excdata;\n"
+        "other.metadata = 0;\v\n"
+    "}\n"
+    "else\n"
+    "{\t\n"
+        "metadata = @excname@::cachedMetadata();\n"
+        "excdata = new (xcomMemAlloc(sizeof(@excname@Data))) @excname@Data(static_cast<@excname@Data&&>(*(@excname@Data*)other.excdata));\v\n"
+    "}\v\n"
+"}\n"
+"\n"
+};
+
+/**
+ * The metadata of the exception is looked up once and kept in a
+ * function local static, which holds its reference until the program
+ * ends. Each exception object takes a new reference. A lookup before
+ * the metadata is registered, as during static initialization, finds
+ * nil. The static is never written again, so later calls look the
+ * metadata up each time and hand over the reference found.
+ */
+TextTmpl::Source exceptionTmpl =
+{
 "struct @excname@ : public @basename@\n"
 "{\t\n"
     "@excname@(bool mostDerived = true)\n"
@@ -368,8 +450,7 @@ char const* exceptionTmpl =
     "{\t\n"
         "if(mostDerived)\n"
         "{\t\n"
-            "metadata = xcom::rawFindMetadata(xcom::getExceptionTypes(), "
-                                           "\"@excname@\");\n"
+            "metadata = @excname@::cachedMetadata();\n"
             "excdata = xcom::allocNew<@excname@Data>();\n"
             "level = @level@;\v\n"
         "}\v\n"
@@ -394,11 +475,12 @@ char const* exceptionTmpl =
         "}\n"
         "else\n"
         "{\t\n"
-            "metadata = xcom::rawFindMetadata(xcom::getExceptionTypes(), \"@excname@\");\n"
+            "metadata = @excname@::cachedMetadata();\n"
             "excdata = new (xcomMemAlloc(sizeof(@excname@Data))) @excname@Data(*(@excname@Data*)other.excdata);\v\n"
         "}\v\n"
     "}\n"
     "\n"
+    "@moves@"
     "~@excname@()\n"
     "{\t\n"
         "if(level == @level@ && metadata != 0)\n"
@@ -413,8 +495,7 @@ char const* exceptionTmpl =
     "{\t\n"
         "@excname@ exc(false);\n"
         "\n"
-        "exc.metadata = xcom::rawFindMetadata(xcom::getExceptionTypes(),"
-                                           "\"@excname@\" );\n"
+        "exc.metadata = @excname@::cachedMetadata();\n"
         "exc.excdata = data;\n"
         "exc.level = @level@;\n"
         "\n"
@@ -424,10 +505,68 @@ char const* exceptionTmpl =
     "static void excThrower(void* data)\n"
     "{\t\n"
         "throw @excname@::adopt(data);\v\n"
+    "}\n"
+    "\n"
+    "static xcom::IUnknownRaw* cachedMetadata()\n"
+    "{\t\n"
+        "static xcom::IUnknownRaw* const md =\t\n"
+            "xcom::rawFindMetadata(xcom::getExceptionTypes(), \"@excname@\");\v\n"
+        "\n"
+        "if(md == 0)\n"
+        "{\t\n"
+            "return xcom::rawFindMetadata(xcom::getExceptionTypes(), \"@excname@\");\v\n"
+        "}\n"
+        "\n"
+        "xcom::IUnknown ref(md);\n"
+        "\n"
+        "ref.addRef();\n"
+        "return ref.detach();\v\n"
     "}\v\n"
-"};\n";
+"};\n"
+};
 
-std::string genException(IException const& exc)
+std::string genMoves(IException const& exc)
+{
+    TextTmpl tmpl(moveTmpl, 4);
+    const IException base(exc.getBase());
+    const std::string name(baseName(exc));
+    const std::string level(intToStr(calculateLevel(exc)));
+
+    // Move constructor
+    tmpl.addParam(name);
+    tmpl.addParam(name);
+    if(base.isNil())
+    {
+        tmpl.skipParam();
+    }
+    else
+    {
+        tmpl.addParam(": " + scopedName(base) + "(false)\n");
+    }
+
+    // Assignments
+    tmpl.addParam(name);
+    tmpl.addParam(name);
+    tmpl.addParam(name);
+    tmpl.addParam(name);
+    tmpl.addParam(level);
+    tmpl.addParam(name);
+
+    // takeData
+    tmpl.addParam(name);
+    tmpl.addParam(level);
+    tmpl.addParam(level);
+    tmpl.addParam(name);
+    tmpl.addParam(name);
+    tmpl.addParam(name);
+    tmpl.addParam(name);
+    tmpl.addParam(name);
+
+    return tmpl();
+}
+
+std::string genException(IException const& exc,
+                         CodeGenOptions const& options)
 {
     const IException base(exc.getBase());
     const std::string name(baseName(exc));
@@ -473,6 +612,14 @@ std::string genException(IException const& exc)
     tmpl.addParam(name);
     tmpl.addParam(name);
 
+    if(options.cxx11)
+    {
+        tmpl.addParam(genMoves(exc));
+    }
+    else
+    {
+        tmpl.skipParam();
+    }
 
     tmpl.addParam(name);
     tmpl.addParam(level);
@@ -482,21 +629,26 @@ std::string genException(IException const& exc)
     tmpl.addParam(name);
     tmpl.addParam(level);
     tmpl.addParam(name);
+    tmpl.addParam(name);
+    tmpl.addParam(name);
     
     return tmpl();
 }
 
 } // namespace  <unnamed>
 
-ExceptionGen::ExceptionGen(IException const& exceptionType, RuleBase& rules)
-: type_(exceptionType), rules_(rules)
+ExceptionGen::ExceptionGen(IException const& exceptionType, RuleBase& rules,
+                           CodeGenOptions const& options)
+: type_(exceptionType), rules_(rules), options_(options)
 {
 }
 
-char const* typesTmpl =
+TextTmpl::Source typesTmpl =
+{
 "@excRawData@"
 "@excData@\n"
-"@exc@\n";
+"@exc@\n"
+};
 
 std::string ExceptionGen::genType()
 {
@@ -506,13 +658,13 @@ std::string ExceptionGen::genType()
     {
         tmpl.addParam(genRawException(type_, baseName(type_) + "RawData", rules_) + '\n');
         tmpl.addParam(genExceptionData(type_, rules_));
-        tmpl.addParam(genException(type_));
+        tmpl.addParam(genException(type_, options_));
     }
     else
     {
         tmpl.skipParam();
         tmpl.addParam(genRawException(type_, baseName(type_) + "Data", rules_));
-        tmpl.addParam(genException(type_));
+        tmpl.addParam(genException(type_, options_));
     }
 
     return tmpl();
@@ -524,12 +676,12 @@ std::string ExceptionGen::genMetadata()
     
     tmpl.addParam(scopedName(type_.getName().c_str()));
     tmpl.addParam(type_.getName().c_str());
-    tmpl.addParam(type_.getName().c_str());
-    tmpl.addParam(genMDTypes(type_));
+    tmpl.addParam(genTypeExists(type_.getName().c_str(), options_));
+    tmpl.addParam(genMDTypes(type_, options_));
     tmpl.addParam(genMDNames(type_));
     tmpl.addParam(genMDOffsets(type_, (scopedName(type_) +
                                        rawSuffix(type_, rules_)).c_str()));
-    tmpl.addParam(genMDBase(type_, rules_));
+    tmpl.addParam(genMDBase(type_, options_));
     tmpl.addParam(type_.getName().c_str());
     tmpl.addParam((scopedName(type_) + rawSuffix(type_, rules_)).c_str());
     tmpl.addParam(intToStr(type_.getMemberCount()));
@@ -537,11 +689,13 @@ std::string ExceptionGen::genMetadata()
     return tmpl();
 }
 
-char const* getRegistrarTmpl =
+TextTmpl::Source getRegistrarTmpl =
+{
 "inline void* @excname@::getRegistrar()\n"
 "{\t\n"
     "return &xcom::Registration<@excname@>::reg;\v\n"
-"}\n";
+"}\n"
+};
     
 std::string genRegistrar(IException const& exc)
 {
@@ -28,6 +28,7 @@
 
 #include <xcom/metadata/Exception.hpp>
 #include "RuleBase.hpp"
+#include "CodeGenOptions.hpp"
 
 /**
  * Code generator for struct's.
@@ -39,7 +40,8 @@ public:
      * A code generator for given structure using the given rule base
      * for members.
      */
-    ExceptionGen(xcom::metadata::IException const& type, RuleBase& rules);
+    ExceptionGen(xcom::metadata::IException const& type, RuleBase& rules,
+                 CodeGenOptions const& options);
 
     /**
      * Generate struct definition.
@@ -59,6 +61,7 @@ public:
 private:
     xcom::metadata::IException type_;
     RuleBase& rules_;
+    CodeGenOptions const& options_;
 };
 
 #endif
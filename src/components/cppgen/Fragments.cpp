@@ -0,0 +1,318 @@
+/**
+ * File    : Fragments.cpp
+ * Author  : Emir Uner
+ * Summary : Generated text of each type, rendered before the headers.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Fragments.hpp"
+
+#include <cassert>
+#include <stdexcept>
+#include <mutex>
+#include <thread>
+
+#include <xcom/metadata/Enum.hpp>
+#include <xcom/metadata/Array.hpp>
+#include <xcom/metadata/Sequence.hpp>
+#include <xcom/metadata/Struct.hpp>
+#include <xcom/metadata/Exception.hpp>
+#include <xcom/metadata/Interface.hpp>
+
+#include "Helper.hpp"
+#include "RuleBase.hpp"
+#include "EnumGen.hpp"
+#include "StructGen.hpp"
+#include "ExceptionGen.hpp"
+#include "ArrayGen.hpp"
+#include "SequenceGen.hpp"
+#include "InterfaceGen.hpp"
+#include "DelegateGen.hpp"
+#include "TypeCopy.hpp"
+
+using namespace xcom::metadata;
+using namespace xcomidl;
+
+namespace
+{
+
+std::string genType(IType type, RuleBase& rules,
+                    CodeGenOptions const& options, MethodSet const& noThrow)
+{
+    switch(type.getKind())
+    {
+    case TypeKind::Enum:
+        return EnumGen(xcom::cast<IEnum>(type), options).genType();
+    case TypeKind::Array:
+        return ArrayGen(xcom::cast<IArray>(type), rules, options).genType();
+    case TypeKind::Sequence:
+        return SequenceGen(xcom::cast<ISequence>(type), rules, options).
+            genType();
+    case TypeKind::Struct:
+        return StructGen(xcom::cast<IStruct>(type), rules, options).
+            genType();
+    case TypeKind::Exception:
+        return ExceptionGen(xcom::cast<IException>(type), rules, options).
+            genType();
+    case TypeKind::Interface:
+        return InterfaceGen(xcom::cast<IInterface>(type), rules, options,
+                            noThrow).genType();
+    case TypeKind::Delegate:
+        return DelegateGen(xcom::cast<IDelegate>(type), rules, options).
+            genType();
+    default:
+        assert(false);
+    }
+
+    return "";
+}
+
+std::string genMetadata(IType type, RuleBase& rules,
+                        CodeGenOptions const& options,
+                        MethodSet const& noThrow)
+{
+    switch(type.getKind())
+    {
+    case TypeKind::Enum:
+        return EnumGen(xcom::cast<IEnum>(type), options).genMetadata();
+        break;
+    case TypeKind::Array:
+        return ArrayGen(xcom::cast<IArray>(type), rules, options).
+            genMetadata();
+        break;
+    case TypeKind::Sequence:
+        return SequenceGen(xcom::cast<ISequence>(type), rules, options).
+            genMetadata();
+        break;
+    case TypeKind::Struct:
+        return StructGen(xcom::cast<IStruct>(type), rules, options).
+            genMetadata();
+        break;
+    case TypeKind::Exception:
+        return ExceptionGen(xcom::cast<IException>(type), rules, options).
+            genMetadata();
+        break;
+    case TypeKind::Interface:
+        return InterfaceGen(xcom::cast<IInterface>(type), rules, options,
+                            noThrow).genMetadata();
+        break;
+    case TypeKind::Delegate:
+        return DelegateGen(xcom::cast<IDelegate>(type), rules, options).
+            genMetadata();
+
+    default:
+        assert(false);
+    }
+
+    return "";
+}
+
+/**
+ * Render all sections of a single type.
+ */
+void renderType(IType const& type, int kind, RuleBase& rules,
+                CodeGenOptions const& options, MethodSet const& noThrow,
+                TypeFragments& out)
+{
+    out.type = genType(type, rules, options, noThrow);
+    out.metadata = genMetadata(type, rules, options, noThrow);
+
+    if(kind == TypeKind::Interface)
+    {
+        InterfaceGen gen(xcom::cast<IInterface>(type), rules, options,
+                         noThrow);
+        
+        out.methods = gen.genMethods();
+        out.metadataForward = gen.genMetadataForward();
+        out.tie = gen.genTie();
+    }
+    else if(kind == TypeKind::Exception)
+    {
+        out.exceptionMethods =
+            ExceptionGen(xcom::cast<IException>(type), rules,
+                         options).genMethods();
+    }
+}
+
+/**
+ * Hands out the GenType steps to the rendering threads and keeps the
+ * error of the failed step with the lowest index, which is the error
+ * a single thread would report.
+ */
+class StepQueue
+{
+public:
+    StepQueue(CodeGenPlan const& plan, CodeGenOptions const& options,
+              Fragments& fragments)
+    : steps_(plan.getSteps()), noThrow_(plan.getNoThrowMethods()),
+      options_(options), fragments_(fragments),
+      next_(0), failed_(-1)
+    {
+    }
+
+    /**
+     * Render steps until none is left or a type failed. Threads render
+     * copies of the types unless shared is true, since metadata objects
+     * may not be shared between threads. Each thread copies the types
+     * it takes, only reading the original types is serialized.
+     */
+    void work(bool shared)
+    {
+        RuleBase rules;
+        TypeCopy copies;
+        int index;
+        
+        while((index = take()) >= 0)
+        {
+            try
+            {
+                IType type(shared ? steps_[index].type :
+                           copyType(copies, index));
+                
+                renderType(type, steps_[index].kind, rules, options_,
+                           noThrow_, fragments_[index]);
+            }
+            catch(std::exception& e)
+            {
+                fail(index, e.what());
+            }
+            catch(...)
+            {
+                fail(index, "unknown error while generating " +
+                     steps_[index].parameter);
+            }
+        }
+    }
+
+    /**
+     * Throw the error of the first failed step if any type failed.
+     */
+    void check() const
+    {
+        if(failed_ >= 0)
+        {
+            throw std::runtime_error(error_);
+        }
+    }
+    
+private:
+    std::vector<PlanStep> const& steps_;
+    MethodSet const& noThrow_;
+    CodeGenOptions const& options_;
+    Fragments& fragments_;
+    std::mutex lock_;
+    std::mutex originalsLock_;
+    int next_;
+    int failed_; // index of the failed step, -1 if none failed
+    std::string error_;
+
+    /**
+     * Index of the next GenType step, -1 if no more work.
+     */
+    int take()
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+
+        while(failed_ < 0 && next_ < (int)steps_.size())
+        {
+            int index = next_++;
+            
+            if(steps_[index].hint == CodeGenHint::GenType)
+            {
+                return index;
+            }
+        }
+
+        return -1;
+    }
+
+    /**
+     * Copy the type of the step with the given copier.
+     */
+    IType copyType(TypeCopy& copies, int index)
+    {
+        std::lock_guard<std::mutex> guard(originalsLock_);
+
+        return copies.copy(steps_[index].type);
+    }
+    
+    /**
+     * Steps are taken in order, so a step failing after another may
+     * still have a lower index.
+     */
+    void fail(int index, std::string const& error)
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+
+        if(failed_ < 0 || index < failed_)
+        {
+            failed_ = index;
+            error_ = error;
+        }
+    }
+};
+
+/**
+ * Thread body.
+ */
+void renderSteps(StepQueue* queue)
+{
+    queue->work(false);
+}
+    
+} // namespace <unnamed>
+
+void renderFragments(CodeGenPlan const& plan, CodeGenOptions const& options,
+                     Fragments& fragments)
+{
+    StepQueue queue(plan, options, fragments);
+    int threads = options.threads;
+    
+    fragments.clear();
+    fragments.resize(plan.getSteps().size());
+
+    if(threads > (int)plan.getTypes().size())
+    {
+        threads = (int)plan.getTypes().size();
+    }
+
+    if(threads <= 1)
+    {
+        queue.work(true);
+    }
+    else
+    {
+        std::vector<std::thread> workers;
+
+        for(int i = 0; i < threads; ++i)
+        {
+            workers.push_back(std::thread(renderSteps, &queue));
+        }
+
+        for(int i = 0; i < threads; ++i)
+        {
+            workers[i].join();
+        }
+    }
+
+    queue.check();
+}
@@ -0,0 +1,66 @@
+/**
+ * File    : Fragments.hpp
+ * Author  : Emir Uner
+ * Summary : Generated text of each type, rendered before the headers.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_CPPGEN_FRAGMENTS_HPP_INCLUDED
+#define XCOMIDL_CPPGEN_FRAGMENTS_HPP_INCLUDED
+
+#include "CodeGenPlan.hpp"
+#include "CodeGenOptions.hpp"
+
+#include <string>
+#include <vector>
+
+/**
+ * The text generated for a type in each section of the headers.
+ * Sections that do not apply to the kind of the type are empty.
+ */
+struct TypeFragments
+{
+    std::string type;
+    std::string methods;
+    std::string metadataForward;
+    std::string metadata;
+    std::string exceptionMethods;
+    std::string tie;
+};
+
+/**
+ * Fragments of the steps of a plan, by step index.
+ */
+typedef std::vector<TypeFragments> Fragments;
+
+/**
+ * Render the fragments of every GenType step of the plan, the element
+ * at an index belongs to the step at the same index. Types are rendered
+ * by the number of threads in the options, each with its own rules
+ * and its own copies of the types.
+ * Throws the error of the first failing type.
+ */
+void renderFragments(CodeGenPlan const& plan,
+                     CodeGenOptions const& options,
+                     Fragments& fragments);
+
+#endif
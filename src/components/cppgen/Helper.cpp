@@ -43,32 +43,86 @@
 
 #include <xcom/GUID.hpp>
 #include <xcom/metadata/Declared.hpp>
+#include <xcomidl/Hash.hpp>
 
 using namespace xcom::metadata;
 
 namespace
 {
 
-char const* rawFindOrRegTmpl =
-"rawFindOrReg(types, \"@scopedIdlName@\", &TypeDesc<@scopedName@>::addSelf)";
+TextTmpl::Source rawFindOrRegTmpl =
+{
+"rawFindOrReg(types, \"@scopedIdlName@\", &TypeDesc<@scopedName@>::addSelf)"
+};
+
+TextTmpl::Source rawFindMetadataTmpl =
+{
+"rawFindMetadata(types, \"@idlName@\")"
+};
+
+TextTmpl::Source hashedRawFindOrRegTmpl =
+{
+"xcomidl::hashedRawFindOrReg(types, \"@scopedIdlName@\", @hash@, "
+                            "&TypeDesc<@scopedName@>::addSelf)"
+};
+
+TextTmpl::Source hashedRawFindMetadataTmpl =
+{
+"xcomidl::hashedRawFindMetadata(types, \"@idlName@\", @hash@)"
+};
+
+TextTmpl::Source typeRefTmpl =
+{
+"{ \"@idlName@\", @hash@, @addSelf@ }"
+};
+
+TextTmpl::Source typeExistsTmpl =
+{
+"typeExists(types, \"@idlName@\")"
+};
+
+TextTmpl::Source hashedTypeExistsTmpl =
+{
+"xcomidl::hashedTypeExists(types, \"@idlName@\", @hash@)"
+};
 
-char const* rawFindMetadataTmpl =
-"rawFindMetadata(types, \"@idlName@\")";
+TextTmpl::Source defaultedMovesTmpl =
+{
+"@name@() = default;\n"
+"@name@(@name@ const&) = default;\n"
+"@name@(@name@&&) = default;\n"
+"@name@& operator=(@name@ const&) = default;\n"
+"@name@& operator=(@name@&&) = default;\n"
+};
 
 } // namespace <unnamed>
 
-std::string genRawFind(IType const& type)
+std::string genRawFind(IType const& type, CodeGenOptions const& options)
 {
     if(isBuiltin(type.getKind()))
-    {    
+    {
+        if(options.hashedRegistry)
+        {
+            return TextTmpl(hashedRawFindMetadataTmpl, 4)
+                .addParam(::idlName(type))
+                .addParam(genNameHash(::idlName(type)))();
+        }
+        
         return TextTmpl(rawFindMetadataTmpl, 4).addParam(::idlName(type))();
     }
     else
     {
         IDeclared decl(xcom::cast<IDeclared>(type));
-        TextTmpl tmpl(rawFindOrRegTmpl, 4);
+        TextTmpl tmpl(options.hashedRegistry ?
+                      hashedRawFindOrRegTmpl : rawFindOrRegTmpl, 4);
     
         tmpl.addParam(decl.getName().c_str());
+
+        if(options.hashedRegistry)
+        {
+            tmpl.addParam(genNameHash(decl.getName().c_str()));
+        }
+        
         if(type.getKind() == TypeKind::Enum)
         {
             tmpl.addParam(::scopedName(decl.getName().c_str()) + "Enum");
@@ -82,6 +136,61 @@ std::string genRawFind(IType const& type)
     }
 }
 
+std::string genTypeRef(IType const& type, CodeGenOptions const& options)
+{
+    TextTmpl tmpl(typeRefTmpl, 4);
+    const std::string name(scopedIdlName(type));
+
+    tmpl.addParam(name);
+    tmpl.addParam(options.hashedRegistry ? genNameHash(name) : "0");
+    
+    if(isBuiltin(type.getKind()))
+    {
+        tmpl.addParam("0");
+    }
+    else
+    {
+        tmpl.addParam("&TypeDesc<" + typeDescName(type) + ">::addSelf");
+    }
+
+    return tmpl();
+}
+
+std::string genTypeExists(std::string const& idlName,
+                          CodeGenOptions const& options)
+{
+    if(options.hashedRegistry)
+    {
+        return TextTmpl(hashedTypeExistsTmpl, 4)
+            .addParam(idlName)
+            .addParam(genNameHash(idlName))();
+    }
+
+    return TextTmpl(typeExistsTmpl, 4).addParam(idlName)();
+}
+
+std::string genNameHash(std::string const& idlName)
+{
+    char buf[16];
+
+    sprintf(buf, "0x%08Xu", xcomidl::nameHash(idlName.c_str()));
+
+    return buf;
+}
+
+std::string genDefaultedMoves(std::string const& name)
+{
+    TextTmpl tmpl(defaultedMovesTmpl, 4);
+
+    // Every field of the template is the class name.
+    for(int i = 0; i < 9; ++i)
+    {
+        tmpl.addParam(name);
+    }
+
+    return tmpl();
+}
+
 std::string scopedName(std::string const& idlName)
 {
     std::string result;
@@ -32,6 +32,8 @@
 #include <xcom/Types.hpp>
 #include <xcom/metadata/Type.hpp>
 
+#include "CodeGenOptions.hpp"
+
 /**
  * Writes the given string vector to standard output prepending and appending
  * given strings.
@@ -92,9 +94,37 @@ std::string basePart(std::string const& name);
 
 /**
  * Depending to the type of the parameter generate
- * a string which either calls rawFindOrReg or rawFindMetadata.
+ * a string which either calls rawFindOrReg or rawFindMetadata,
+ * or their hashed equivalents.
+ */
+std::string genRawFind(xcom::metadata::IType const& type,
+                       CodeGenOptions const& options);
+
+/**
+ * Generate the xcomidl::TypeRef initializer that refers to the type
+ * from a static metadata table.
+ */
+std::string genTypeRef(xcom::metadata::IType const& type,
+                       CodeGenOptions const& options);
+
+/**
+ * Generate the test whether the type with the given idl name is
+ * registered.
+ */
+std::string genTypeExists(std::string const& idlName,
+                          CodeGenOptions const& options);
+
+/**
+ * Hash constant of the given type name for the hashed registry.
+ */
+std::string genNameHash(std::string const& idlName);
+
+/**
+ * Generate defaulted C++11 copy and move operations for the named
+ * wrapper class. Moves are member-wise, and they are noexcept when
+ * the moves of all members are.
  */
-std::string genRawFind(xcom::metadata::IType const& type);
+std::string genDefaultedMoves(std::string const& name);
 
 /**
  * Splits a given string into substrings that are separated with the
@@ -28,30 +28,31 @@
 #define XCOM_TOOLS_IDLTOCPP_INDENTEDOUTPUT_HPP_INCLUDED
 
 #include <string>
-#include <ostream>
+#include <cstring>
 
 /**
  * A loosely encapsulated/internal indented output capable
  * stream class.
+ * Output is appended to a string that holds the whole generated file,
+ * so that it is written with a single write. Lines are copied as whole
+ * runs between newlines.
  */
 class IndentedOutput
 {
 public:
-    IndentedOutput(std::ostream& os, int indentLen)
-    : os_(os), indent_(indentLen), level_(0)
+    IndentedOutput(std::string& buffer, int indentLen)
+    : buffer_(buffer), indent_(indentLen), level_(0)
     {
     }
 
     void operator++()
     {
         ++level_;
-        spaces_ = std::string(level_ * indent_, ' ');
     }
     
     void operator--()
     {
         --level_;
-        spaces_ = std::string(level_ * indent_, ' ');
     }
     
     /**
@@ -60,7 +61,7 @@ public:
     void writeLine(std::string const& line)
     {
         write(line);
-        os_.put('\n');
+        buffer_ += '\n';
     }
 
     /**
@@ -68,7 +69,7 @@ public:
      */
     void write(std::string const& line)
     {
-        os_ << spaces_;
+        buffer_.append(level_ * indent_, ' ');
         nwrite(line);
     }
     
@@ -77,15 +78,25 @@ public:
      */
     void nwrite(std::string const& line)
     {
-        for(std::string::const_iterator s = line.begin(); s != line.end(); ++s)
+        char const* begin = line.data();
+        char const* end = begin + line.size();
+        char const* newline;
+
+        if(level_ == 0)
+        {
+            buffer_.append(begin, end - begin);
+            return;
+        }
+        
+        while((newline = static_cast<char const*>(
+                   std::memchr(begin, '\n', end - begin))) != 0)
         {
-            os_.put(*s);
-            
-            if(*s == '\n')
-            {
-                os_ << spaces_;
-            }
+            buffer_.append(begin, newline + 1 - begin);
+            buffer_.append(level_ * indent_, ' ');
+            begin = newline + 1;
         }
+
+        buffer_.append(begin, end - begin);
     }
     
     /**
@@ -93,24 +104,14 @@ public:
      */
     void nwriteLine(std::string const& line)
     {
-        for(std::string::const_iterator s = line.begin(); s != line.end(); ++s)
-        {
-            os_.put(*s);
-            
-            if(*s == '\n')
-            {
-                os_ << spaces_;
-            }
-        }
-
-        os_ << '\n';
+        nwrite(line);
+        buffer_ += '\n';
     }
     
 private:
-    std::ostream& os_;
+    std::string& buffer_;
     int indent_;
     int level_;
-    std::string spaces_;
 };
 
 #endif
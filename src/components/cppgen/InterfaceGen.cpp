@@ -59,26 +59,37 @@ int calculateMaxParam(IInterface const& itf)
     return (int)max;
 }
 
-char const* assignNameTmpl =
-"pnames[@paramIndex@] = \"@paramName@\";\n";
+TextTmpl::Source assignNameTmpl =
+{
+"pnames[@paramIndex@] = \"@paramName@\";\n"
+};
 
-char const* assignTypeTmpl =
-"ptypes[@paramIndex@] = @findType@;\n";
+TextTmpl::Source assignTypeTmpl =
+{
+"ptypes[@paramIndex@] = @findType@;\n"
+};
 
-char const* assignModeTmpl =
-"pmodes[@paramIndex@] = @paramMode@;\n";
+TextTmpl::Source assignModeTmpl =
+{
+"pmodes[@paramIndex@] = @paramMode@;\n"
+};
 
-char const* addMethodToItfTmpl =
+TextTmpl::Source addMethodToItfTmpl =
+{
 "xcomAddMethodToItf(cookie, \"@methodName@\", @findReturnType@, "
-                    "@paramCount@, pmodes, ptypes, pnames);";
+                    "@paramCount@, pmodes, ptypes, pnames);"
+};
     
-char const* addMethodTmpl =
+TextTmpl::Source addMethodTmpl =
+{
 "@names@\n"
 "@types@\n"
 "@modes@\n"
-"@addMethodCall@\n";
+"@addMethodCall@\n"
+};
 
-std::string genAddMethod(IInterface const& itf, int idx)
+std::string genAddMethod(IInterface const& itf, int idx,
+                         CodeGenOptions const& options)
 {
     std::string names, types, modes, addCall;
     const ParamInfoSeq params(itf.getParameters(idx));
@@ -88,22 +99,25 @@ std::string genAddMethod(IInterface const& itf, int idx)
     {
         const std::string paramIndex(intToStr(i-1));
         
-        names += TextTmpl(assignNameTmpl, 4)
+        TextTmpl(assignNameTmpl, 4)
             .addParam(paramIndex)
-            .addParam(params[i].name.c_str())();
+            .addParam(params[i].name.c_str())
+            .expand(names);
 
-        types += TextTmpl(assignTypeTmpl, 4)
+        TextTmpl(assignTypeTmpl, 4)
             .addParam(paramIndex)
-            .addParam(genRawFind(params[i].type))();
+            .addParam(genRawFind(params[i].type, options))
+            .expand(types);
 
-        modes += TextTmpl(assignModeTmpl, 4).
-            addParam(paramIndex).
-            addParam(intToStr(params[i].mode))();
+        TextTmpl(assignModeTmpl, 4)
+            .addParam(paramIndex)
+            .addParam(intToStr(params[i].mode))
+            .expand(modes);
     }
     
     addCall = TextTmpl(addMethodToItfTmpl, 4)
         .addParam(itf.getMethodName(idx).c_str())
-        .addParam(genRawFind(params[0].type))
+        .addParam(genRawFind(params[0].type, options))
         .addParam(intToStr(paramCount - 1))();
     
     return TextTmpl(addMethodTmpl, 4)
@@ -113,42 +127,56 @@ std::string genAddMethod(IInterface const& itf, int idx)
         .addParam(addCall)();
 }
     
-char const* vtblEntryTmpl =
-"@returnType@ (*@methodName@)(void*, xcom::Environment*@parameters@);";
+TextTmpl::Source vtblEntryTmpl =
+{
+"@returnType@ (*@methodName@)(void*, xcom::Environment*@parameters@);"
+};
     
-char const* vtblTmpl =
+TextTmpl::Source vtblTmpl =
+{
 "struct @itfname@Vtbl\n"
 "{\t\n"
     "@entries@\v\n"
-"};\n";
+"};\n"
+};
 
-char const* rawItfTmpl =
+TextTmpl::Source rawItfTmpl =
+{
 "struct @itfname@Raw : public @baseitfname@Raw\n"
 "{\n"
-"};\n";
+"};\n"
+};
 
-char const* rawUnknownTmpl =
+TextTmpl::Source rawUnknownTmpl =
+{
 "struct @itfname@Raw\n"
 "{\t\n"
     "void* vptr_;\v\n"
-"};\n";
+"};\n"
+};
 
-char const* castVtblTmpl = 
-"static_cast<@itfname@Vtbl*>(static_cast<@itfname@Raw*>(ptr_)->vptr_)";
+TextTmpl::Source castVtblTmpl =
+{
+"static_cast<@itfname@Vtbl*>(static_cast<@itfname@Raw*>(ptr_)->vptr_)"
+};
 
-char const* itfForwarderDeclTmpl =
-"@returntype@ @methodname@(@parameters@) const;\n";
+TextTmpl::Source itfForwarderDeclTmpl =
+{
+"@returntype@ @methodname@(@parameters@) const;\n"
+};
 
-char const* voidItfForwarderTmpl =
+TextTmpl::Source voidItfForwarderTmpl =
+{
 "inline void @classname@::@methodname@(@parameters@) const\n"
 "{\t\n"
     "@excinfoobj@"
     "@vtbl@->@methodname@(@parms@);\v\n"
     "@findAndThrow@\n"
 "}\n"
-;
+};
 
-char const* unknownCopyConstrTmpl =
+TextTmpl::Source unknownCopyConstrTmpl =
+{
 "@itfname@(@itfname@ const& other)\n"
 ": ptr_(other.ptr_)"
 "{\t\n"
@@ -156,9 +184,31 @@ char const* unknownCopyConstrTmpl =
     "{\t\n"
         "addRef();\v\n"
     "}\v\n"
-"}\n";
+"}\n"
+};
 
-char const* assignOpTmpl =
+TextTmpl::Source moveTmpl =
+{
+"@copyops@"
+"@itfname@(@itfname@&& other) noexcept\n"
+": @moveinit@"
+"{\t\n"
+    "other.ptr_ = 0;\v\n"
+"}\n"
+"@itfname@& operator=(@itfname@&& rhs) noexcept\n"
+"{\t\n"
+    "if(this != &rhs)\n"
+    "{\t\n"
+        "if(ptr_ != 0) release();\n"
+        "ptr_ = rhs.ptr_;\n"
+        "rhs.ptr_ = 0;\v\n"
+    "}\n"
+    "return *this;\v\n"
+"}\n"
+};
+
+TextTmpl::Source assignOpTmpl =
+{
 "@itfname@& operator=(@itfname@ const& rhs)\n"
 "{\t\n"
     "if(this != &rhs)\n"
@@ -168,9 +218,11 @@ char const* assignOpTmpl =
         "if(ptr_ != 0) addRef();\v\n"
     "}\n"
     "return *this;\v\n"
-"}\n";
+"}\n"
+};
     
-char const* unknownTmpl =
+TextTmpl::Source unknownTmpl =
+{
 "class @itfname@\n"
 "{\n"
 "public:\t\n"
@@ -182,6 +234,7 @@ char const* unknownTmpl =
     "~@itfname@() { if(ptr_ != 0) this->release(); }\n\n"
     "@assignop@\n"
     "@copyconstructor@\n"
+    "@moves@"
     "@forwarders@\n"
     "@adopt@\n"
     "@detach@\n"
@@ -190,17 +243,21 @@ char const* unknownTmpl =
     "operator bool() const { return !isNil(); }\n"
     "bool operator !() const { return isNil(); }\v\n"
 "};\n\n"
-"@xcomcast@\n";
+"@xcomcast@\n"
+};
 
-char const* castTmpl =
+TextTmpl::Source castTmpl =
+{
 "template <typename To, typename From>\n"
 "To cast(From const& from)\n"
 "{\t\n"
     "@itfname@ unk(from.queryInterface(To::thisInterfaceId()));\n"
     "return static_cast<typename To::RawType>(unk.detach());\v\n"
-"}\n";
+"}\n"
+};
 
-char const* itfTmpl =
+TextTmpl::Source itfTmpl =
+{
 "template<typename Impl> class @itfname@Tie;\n"
 "class @itfname@ : public @baseitfname@\n"
 "{\n"
@@ -211,27 +268,34 @@ char const* itfTmpl =
     "struct Tie { typedef @itfname@Tie<T> type; };\n"
     "@itfname@() {}\n"
     "@itfname@(@itfname@Raw* ptr) : @baseitfname@((@baseitfname@Raw*)ptr) {}\n"
+    "@moves@"
     "@forwarders@\n"
     "@adopt@\n"
     "@detach@\n"
     "@guidquery@\v\n"
-"};\n";
+"};\n"
+};
 
-char const* detachTmpl =
+TextTmpl::Source detachTmpl =
+{
 "@itfname@Raw* detach()\n"
 "{\t\n"
     "@itfname@Raw* result = (@itfname@Raw*)ptr_;\n"
     "ptr_ = 0;\n"
     "return result;\v\n"
-"}\n";
+"}\n"
+};
 
-char const* adoptTmpl =
+TextTmpl::Source adoptTmpl =
+{
 "static @itfname@ adopt(@itfname@Raw* src)\n"
 "{\t\n"
     "return @itfname@(src);\v\n"
-"}\n";
+"}\n"
+};
 
-char const* guidQueryTmpl =
+TextTmpl::Source guidQueryTmpl =
+{
 "static inline xcom::GUID const& thisInterfaceId()\n"
 "{\t\n"
     "static const xcom::GUID id =\n"
@@ -241,9 +305,11 @@ char const* guidQueryTmpl =
     "};\n"
     "\n"
     "return id;\v\n"
-"}\n";
+"}\n"
+};
 
-char const* tieClassTmpl =
+TextTmpl::Source tieClassTmpl =
+{
 "template <class Impl>\n"
 "class @itfname@Tie : public @itfname@Raw\n"
 "{\n"
@@ -257,27 +323,33 @@ char const* tieClassTmpl =
 "\n"
 "private:\t\n"
     "static @itfname@Vtbl @itfname@TieVtbl;\v\n"
-"};\n";
+"};\n"
+};
 
-char const* tieVtblEntryTmpl = "&@itfname@Tie<Impl>::@method@__call";
+TextTmpl::Source tieVtblEntryTmpl = { "&@itfname@Tie<Impl>::@method@__call" };
 
-char const* tieVtblTmpl =
+TextTmpl::Source tieVtblTmpl =
+{
 "template <class Impl>\n"
 "@itfname@Vtbl @itfname@Tie<Impl>::@itfname@TieVtbl =\n"
 "{\t\n"
     "@pointers@\v\n"
-"};\n";
+"};\n"
+};
 
-char const* voidTieMethodTmpl =
+TextTmpl::Source voidTieMethodTmpl =
+{
 "static void @methodname@__call(void* ptr, ::xcom::Environment* __exc_info@tieparams@)\n"
 "{\t\n"
     "@try@"
     "static_cast<Impl*>(static_cast<@itfname@Tie<Impl>*>(ptr))->"
         "@methodname@(@params@);\n"
     "\v\n@catch@\n"
-"}\n";
+"}\n"
+};
 
-char const* tieMethodTmpl =
+TextTmpl::Source tieMethodTmpl =
+{
 "static @rettype@ @methodname@__call(void* ptr, ::xcom::Environment* __exc_info@tieparams@)\n"
 "{\t\n"
    "@try@"
@@ -285,36 +357,62 @@ char const* tieMethodTmpl =
       "@methodname@(@params@)@detach@;\n"
    "@catch@\n"
    "@returnsomething@\v\n"
-"}\n";
+"}\n"
+};
+
+TextTmpl::Source noThrowVoidTieMethodTmpl =
+{
+"static void @methodname@__call(void* ptr, ::xcom::Environment*@tieparams@)\n"
+"{\t\n"
+    "static_cast<Impl*>(static_cast<@itfname@Tie<Impl>*>(ptr))->"
+        "@methodname@(@params@);\v\n"
+"}\n"
+};
+
+TextTmpl::Source noThrowTieMethodTmpl =
+{
+"static @rettype@ @methodname@__call(void* ptr, ::xcom::Environment*@tieparams@)\n"
+"{\t\n"
+   "return static_cast<Impl*>(static_cast<@itfname@Tie<Impl>*>(ptr))->"
+      "@methodname@(@params@)@detach@;\v\n"
+"}\n"
+};
 
-char const* getInterfaceIdMethodTmpl =
+TextTmpl::Source getInterfaceIdMethodTmpl =
+{
 "static xcom::GUID getInterfaceId__call(void*, ::xcom::Environment*)\n"
 "{\t\n"
    "return @itfname@::thisInterfaceId();\v\n"
-"}\n";
+"}\n"
+};
 
-char const* itfMetadataFwdTmpl =
+TextTmpl::Source itfMetadataFwdTmpl =
+{
 "template<> struct TypeDesc<@scopedName@>\n"
 "{\t\n"
     "static void addSelf(IUnknownSeq& types);\v\n"
-"};\n";
+"};\n"
+};
 
-char const* emptyItfMetadataTmpl =
+TextTmpl::Source emptyItfMetadataTmpl =
+{
 "inline void TypeDesc<@scopeName@>::addSelf(IUnknownSeq& types)\n"
 "{\t\n"
-    "if(!typeExists(types, \"@idlName@\"))\n"
+    "if(!@typeExists@)\n"
     "{\t\n"
         "void* cookie;\n"
         "@getBase@\n"
         "types.push_back(xcomCreateInterfaceMD(\"@name@\", "
             "&@scopedName@::thisInterfaceId(), base.detach(), &cookie));\v\n"
     "}\v\n"
-"}\n";
+"}\n"
+};
 
-char const* itfMetadataTmpl =
+TextTmpl::Source itfMetadataTmpl =
+{
 "inline void TypeDesc<@scopeName@>::addSelf(IUnknownSeq& types)\n"
 "{\t\n"
-    "if(!typeExists(types, \"@idlName@\"))\n"
+    "if(!@typeExists@)\n"
     "{\t\n"
         "void* cookie;\n"
         "@getBase@\n"
@@ -326,22 +424,79 @@ char const* itfMetadataTmpl =
         "\n"
         "@addMethodMetadatas@\v\n"
     "}\v\n"
-"}\n";
+"}\n"
+};
+
+TextTmpl::Source staticItfMetadataTmpl =
+{
+"inline void TypeDesc<@scopeName@>::addSelf(IUnknownSeq& types)\n"
+"{\t\n"
+    "if(!@typeExists@)\n"
+    "{\t\n"
+        "@methodTables@"
+        "static const xcomidl::InterfaceTable table =\n"
+        "{\t\n"
+            "\"@name@\",\n"
+            "@base@,\n"
+            "@methodCount@, @methods@\v\n"
+        "};\n"
+        "\n"
+        "xcomidl::registerInterface(types, table, "
+                                   "&@scopedName@::thisInterfaceId());\v\n"
+    "}\v\n"
+"}\n"
+};
+
+TextTmpl::Source staticMethodTablesTmpl =
+{
+"@paramTables@"
+"static const xcomidl::MethodTable methods[@methodCount@] =\n"
+"{\t\n"
+    "@methods@\v\n"
+"};\n"
+};
 
-char const* fillParamTmpl =
+TextTmpl::Source staticParamTablesTmpl =
+{
+"static const Int pmodes@index@[@paramCount@] = { @modes@ };\n"
+"static const xcomidl::TypeRef ptypes@index@[@paramCount@] =\n"
+"{\t\n"
+    "@types@\v\n"
+"};\n"
+"static const Char* const pnames@index@[@paramCount@] = { @names@ };\n"
+};
+
+TextTmpl::Source staticMethodTmpl =
+{
+"{ \"@methodName@\", @result@, @paramCount@, @params@ },\n"
+};
+
+TextTmpl::Source fillParamTmpl =
+{
 "param.mode = @mode@;\n"
 "param.type = @findType@;\n"
 "param.name = \"@name@\";\n"
-"params.push_back(param);\n";
+"params.push_back(param);\n"
+};
 
-char const* methodMetadataTmpl =
+TextTmpl::Source methodMetadataTmpl =
+{
 "@populateParams@\n"
 "addMethodToItf(cookie, \"@methodName@\", params);\n"
-"params.clear();\n\n";
+"params.clear();\n\n"
+};
 
-char const* getBaseTmpl =
+TextTmpl::Source getBaseTmpl =
+{
 "IUnknown base(findOrRegister(types, \"@baseIdlName@\", "
-                     "&TypeDesc<@elementScopedName@>::addSelf));";
+                     "&TypeDesc<@elementScopedName@>::addSelf));"
+};
+
+TextTmpl::Source hashedGetBaseTmpl =
+{
+"IUnknown base(xcomidl::hashedFindOrRegister(types, \"@baseIdlName@\", "
+                     "@hash@, &TypeDesc<@elementScopedName@>::addSelf));"
+};
 
 std::string basename(IInterface const& itf)
 {
@@ -501,11 +656,16 @@ std::string castVtbl(IInterface const& itf)
     return tmpl();
 }
     
-std::string genRawCallParams(IInterface const& itf, int idx, RuleBase& rules)
+/**
+ * Arguments of the vtbl call of a forwarder. Nothrow methods are
+ * called with a nil environment, their callers ignore it.
+ */
+std::string genRawCallParams(IInterface const& itf, int idx, RuleBase& rules,
+                             bool noThrow)
 {
     const ParamInfoSeq params(itf.getParameters(idx));
     
-    std::string result("ptr_, &__exc_info");
+    std::string result(noThrow ? "ptr_, 0" : "ptr_, &__exc_info");
     ParamInfoSeq::const_iterator param = params.begin() + 1;
     ParamInfoSeq::const_iterator end = params.end();
     
@@ -560,7 +720,52 @@ std::string genItfForwarderDecl(IInterface const& itf, int idx, RuleBase&rules)
     return tmpl();
 }
 
-std::string genVoidItfForwarder(IInterface const& itf, int idx, RuleBase&rules)
+/**
+ * Returns true if the method of the interface is declared nothrow.
+ */
+bool isNoThrow(MethodSet const& noThrow, IInterface const& itf, int idx)
+{
+    std::string name(itf.getName().c_str());
+
+    name += '.';
+    name += itf.getMethodName(idx).c_str();
+    
+    return noThrow.find(name) != noThrow.end();
+}
+    
+/**
+ * Add the environment of a forwarder, nothing for nothrow methods.
+ */
+void addExcInfo(TextTmpl& tmpl, bool noThrow)
+{
+    if(noThrow)
+    {
+        tmpl.skipParam();
+    }
+    else
+    {
+        tmpl.addParam("xcom::Environment __exc_info;\n");
+    }
+}
+
+/**
+ * Add the exception check of a forwarder, nothing for nothrow methods.
+ */
+void addFindAndThrow(TextTmpl& tmpl, bool noThrow)
+{
+    if(noThrow)
+    {
+        tmpl.skipParam();
+    }
+    else
+    {
+        tmpl.addParam(
+            "if(__exc_info.exception) xcomFindAndThrow(&__exc_info);\n");
+    }
+}
+
+std::string genVoidItfForwarder(IInterface const& itf, int idx, RuleBase&rules,
+                                bool noThrow)
 {
     const ParamInfoSeq params(itf.getParameters(idx));
     const xcom::String methodName(itf.getMethodName(idx));
@@ -569,25 +774,28 @@ std::string genVoidItfForwarder(IInterface const& itf, int idx, RuleBase&rules)
     tmpl.addParam(basename(itf));
     tmpl.addParam(methodName.c_str());
     tmpl.addParam(genItfParams(params, rules));
-    tmpl.addParam("xcom::Environment __exc_info;\n");
+    addExcInfo(tmpl, noThrow);
     tmpl.addParam(castVtbl(itf));
     tmpl.addParam(methodName.c_str());
-    tmpl.addParam(genRawCallParams(itf, idx, rules));
-    tmpl.addParam("if(__exc_info.exception) xcomFindAndThrow(&__exc_info);\n");
+    tmpl.addParam(genRawCallParams(itf, idx, rules, noThrow));
+    addFindAndThrow(tmpl, noThrow);
 
     return tmpl();
 }
 
-char const* itfForwarderTmpl =
+TextTmpl::Source itfForwarderTmpl =
+{
 "inline @rettype@ @classname@::@methodname@(@parameters@) const\n"
 "{\t\n"
     "@excinfoobj@"
     "@rettype@ result(@adoptbegin@@vtbl@->@methodname@(@parms@)@adoptend@);\n"
     "@findAndThrow@\n"
     "return result;\v\n"
-"}\n";
+"}\n"
+};
 
-std::string genItfForwarder(IInterface const& itf, int idx, RuleBase& rules)
+std::string genItfForwarder(IInterface const& itf, int idx, RuleBase& rules,
+                           bool noThrow)
 {
     const ParamInfoSeq params(itf.getParameters(idx));
     const xcom::String methodName(itf.getMethodName(idx));
@@ -598,7 +806,7 @@ std::string genItfForwarder(IInterface const& itf, int idx, RuleBase& rules)
     tmpl.addParam(basename(itf));
     tmpl.addParam(methodName.c_str());
     tmpl.addParam(genItfParams(params, rules));
-    tmpl.addParam("xcom::Environment __exc_info;\n");
+    addExcInfo(tmpl, noThrow);
     
     tmpl.addParam(returnRules->returnType());
     if(returnRules->isComplex())
@@ -612,7 +820,7 @@ std::string genItfForwarder(IInterface const& itf, int idx, RuleBase& rules)
     
     tmpl.addParam(castVtbl(itf));
     tmpl.addParam(methodName.c_str());
-    tmpl.addParam(genRawCallParams(itf, idx, rules));
+    tmpl.addParam(genRawCallParams(itf, idx, rules, noThrow));
     
     if(returnRules->isComplex())
     {
@@ -623,7 +831,7 @@ std::string genItfForwarder(IInterface const& itf, int idx, RuleBase& rules)
         tmpl.skipParam();
     }
 
-    tmpl.addParam("if(__exc_info.exception) xcomFindAndThrow(&__exc_info);\n");
+    addFindAndThrow(tmpl, noThrow);
     return tmpl();    
 }
 
@@ -639,7 +847,8 @@ std::string genItfForwardersDecls(IInterface const& itf, RuleBase& rules)
     return result;
 }
 
-std::string genItfForwarders(IInterface const& itf, RuleBase& rules)
+std::string genItfForwarders(IInterface const& itf, RuleBase& rules,
+                             MethodSet const& noThrow)
 {
     std::string result;
     
@@ -649,11 +858,13 @@ std::string genItfForwarders(IInterface const& itf, RuleBase& rules)
         
         if(nonVoidReturn(params))
         {
-            result += genItfForwarder(itf, i, rules);
+            result += genItfForwarder(itf, i, rules,
+                                      isNoThrow(noThrow, itf, i));
         }
         else
         {
-            result += genVoidItfForwarder(itf, i, rules);
+            result += genVoidItfForwarder(itf, i, rules,
+                                          isNoThrow(noThrow, itf, i));
         }
     }
 
@@ -694,7 +905,51 @@ std::string genUnknownCopyConstr(std::string const& itfname)
     return tmpl();
 }
     
-std::string genUnknownClass(IInterface const& itf, RuleBase& rules)
+/**
+ * Generate C++11 move operations. The root class has its own copy
+ * operations, derived classes get defaulted ones which the moves
+ * would otherwise suppress.
+ */
+std::string genMoves(IInterface const& itf)
+{
+    TextTmpl tmpl(moveTmpl, 4);
+    const std::string itfname = basename(itf);
+
+    if(itf.getBase().isNil())
+    {
+        tmpl.skipParam();
+    }
+    else
+    {
+        tmpl.addParam(
+            itfname + "(" + itfname + " const&) = default;\n" +
+            itfname + "& operator=(" + itfname + " const&) = default;\n");
+    }
+    
+    tmpl.addParam(itfname);
+    tmpl.addParam(itfname);
+
+    if(itf.getBase().isNil())
+    {
+        tmpl.addParam("ptr_(other.ptr_)\n");
+    }
+    else
+    {
+        const std::string baseitfname =
+            scopedName(itf.getBase().getName().c_str());
+        
+        tmpl.addParam(baseitfname + "((" + baseitfname +
+                      "Raw*)other.ptr_)\n");
+    }
+    
+    tmpl.addParam(itfname);
+    tmpl.addParam(itfname);
+
+    return tmpl();
+}
+
+std::string genUnknownClass(IInterface const& itf, RuleBase& rules,
+                            CodeGenOptions const& options)
 {
     TextTmpl tmpl(unknownTmpl, 4);
     const std::string itfname = basename(itf);
@@ -708,6 +963,16 @@ std::string genUnknownClass(IInterface const& itf, RuleBase& rules)
     tmpl.addParam(itfname);
     tmpl.addParam(genUnknownAssignOp(itfname));
     tmpl.addParam(genUnknownCopyConstr(itfname));
+
+    if(options.cxx11)
+    {
+        tmpl.addParam(genMoves(itf));
+    }
+    else
+    {
+        tmpl.skipParam();
+    }
+    
     tmpl.addParam(genItfForwardersDecls(itf, rules));
     tmpl.addParam(genAdopt(itf));
     tmpl.addParam(genDetach(itf));
@@ -717,7 +982,8 @@ std::string genUnknownClass(IInterface const& itf, RuleBase& rules)
     return tmpl();
 }
 
-std::string genItfClass(IInterface const& itf, RuleBase& rules)
+std::string genItfClass(IInterface const& itf, RuleBase& rules,
+                        CodeGenOptions const& options)
 {
     TextTmpl tmpl(itfTmpl, 4);
     const std::string itfname = basename(itf);
@@ -735,6 +1001,16 @@ std::string genItfClass(IInterface const& itf, RuleBase& rules)
     tmpl.addParam(itfname);
     tmpl.addParam(baseitfname);
     tmpl.addParam(baseitfname);
+
+    if(options.cxx11)
+    {
+        tmpl.addParam(genMoves(itf));
+    }
+    else
+    {
+        tmpl.skipParam();
+    }
+    
     tmpl.addParam(genItfForwardersDecls(itf, rules));
     tmpl.addParam(genAdopt(itf));
     tmpl.addParam(genDetach(itf));
@@ -788,7 +1064,7 @@ char const* catchBlock =
 "} catch(xcom::UserExc& ue) { ue.detach(__exc_info); }";
 
 std::string genTieMethod(IInterface const& real, IInterface const& current,
-                         int idx, RuleBase& rules)
+                         int idx, RuleBase& rules, bool noThrow)
 {
     const ParamInfoSeq params(current.getParameters(idx));
     const xcom::String methodName(current.getMethodName(idx));
@@ -812,6 +1088,29 @@ std::string genTieMethod(IInterface const& real, IInterface const& current,
         }
     }
     
+    if(noThrow)
+    {
+        TextTmpl tmpl(noThrowTieMethodTmpl, 4);
+
+        tmpl.addParam(returnRules->rawReturnType());
+        tmpl.addParam(methodName.c_str());
+        tmpl.addParam(genTieParams(current, idx, rules));
+        tmpl.addParam(basename(real));
+        tmpl.addParam(methodName.c_str());
+        tmpl.addParam(genCallParams(params, rules));
+
+        if(returnRules->isComplex())
+        {
+            tmpl.addParam(".detach()");
+        }
+        else
+        {
+            tmpl.skipParam();
+        }
+
+        return tmpl();
+    }
+    
     TextTmpl tmpl(tieMethodTmpl, 4);
     
     tmpl.addParam(returnRules->rawReturnType());
@@ -849,10 +1148,23 @@ std::string genTieMethod(IInterface const& real, IInterface const& current,
 }
 
 std::string genVoidTieMethod(IInterface const& real, IInterface const& current,
-                             int idx, RuleBase& rules)
+                             int idx, RuleBase& rules, bool noThrow)
 {
     const ParamInfoSeq params(current.getParameters(idx));
     const xcom::String methodName(current.getMethodName(idx));
+
+    if(noThrow)
+    {
+        TextTmpl tmpl(noThrowVoidTieMethodTmpl, 4);
+
+        tmpl.addParam(methodName.c_str());
+        tmpl.addParam(genTieParams(current, idx, rules));
+        tmpl.addParam(basename(real));
+        tmpl.addParam(methodName.c_str());
+        tmpl.addParam(genCallParams(params, rules));
+
+        return tmpl();
+    }
     
     TextTmpl tmpl(voidTieMethodTmpl, 4);
     
@@ -871,24 +1183,26 @@ std::string genVoidTieMethod(IInterface const& real, IInterface const& current,
 }
 
 std::string genTieMethods(IInterface const& itf, RuleBase& rules,
-                          IInterface const& actual)
+                          IInterface const& actual, MethodSet const& noThrow)
 {
     std::string result;
 
     if(!itf.getBase().isNil())
     {
-        result = genTieMethods(itf.getBase(), rules, actual);
+        result = genTieMethods(itf.getBase(), rules, actual, noThrow);
     }
 
     for(int i = 0; i < itf.getMethodCount(); ++i)
     {
         if(nonVoidReturn(itf.getParameters(i)))
         {
-            result += genTieMethod(actual, itf, i, rules);
+            result += genTieMethod(actual, itf, i, rules,
+                                   isNoThrow(noThrow, itf, i));
         }
         else
         {
-            result += genVoidTieMethod(actual, itf, i, rules);
+            result += genVoidTieMethod(actual, itf, i, rules,
+                                       isNoThrow(noThrow, itf, i));
         }
 
         result += '\n';
@@ -898,14 +1212,15 @@ std::string genTieMethods(IInterface const& itf, RuleBase& rules,
 }
 
     
-std::string genTieClass(IInterface const& itf, RuleBase& rules)
+std::string genTieClass(IInterface const& itf, RuleBase& rules,
+                        MethodSet const& noThrow)
 {
     TextTmpl tmpl(tieClassTmpl, 4);
     std::string bn(basename(itf));
 
     tmpl.addParam(bn);
     tmpl.addParam(bn);
-    tmpl.addParam(genTieMethods(itf, rules, itf));
+    tmpl.addParam(genTieMethods(itf, rules, itf, noThrow));
     tmpl.addParam(bn);
     tmpl.addParam(bn);
     tmpl.addParam(bn);
@@ -954,29 +1269,112 @@ std::string genTieVtbl(IInterface const& itf)
     return tmpl();
 }
 
-std::string genMethodMetadatas(IInterface const& type)
+std::string genMethodMetadatas(IInterface const& type,
+                               CodeGenOptions const& options)
 {
     const int methodCount = type.getMethodCount();
     std::string methods;
     
     for(xcom::Int i = 0; i < methodCount; ++i)
     {
-        methods += genAddMethod(type, i);
+        methods += genAddMethod(type, i, options);
     }
     
     return methods;
 }
 
-std::string genGetBase(IInterface const& type)
+/**
+ * Generate the parameter tables and the method table for
+ * staticItfMetadataTmpl.
+ */
+std::string genStaticMethodTables(IInterface const& type,
+                                  CodeGenOptions const& options)
+{
+    const int methodCount = type.getMethodCount();
+    std::string paramTables, methods;
+    
+    for(int i = 0; i < methodCount; ++i)
+    {
+        const ParamInfoSeq params(type.getParameters(i));
+        const int paramCount = (int)params.size() - 1;
+        const std::string index(intToStr(i));
+        TextTmpl method(staticMethodTmpl, 4);
+
+        method.addParam(type.getMethodName(i).c_str());
+        method.addParam(genTypeRef(params[0].type, options));
+        method.addParam(intToStr(paramCount));
+        
+        if(paramCount == 0)
+        {
+            method.addParam("0, 0, 0");
+        }
+        else
+        {
+            std::vector<std::string> modes, types, names;
+            
+            for(int p = 1; p <= paramCount; ++p)
+            {
+                modes.push_back(intToStr(params[p].mode));
+                types.push_back(genTypeRef(params[p].type, options));
+                names.push_back('"' + std::string(params[p].name.c_str()) +
+                                '"');
+            }
+
+            TextTmpl(staticParamTablesTmpl, 4)
+                .addParam(index)
+                .addParam(intToStr(paramCount))
+                .addParam(joinStrings(modes, ", "))
+                .addParam(index)
+                .addParam(intToStr(paramCount))
+                .addParam(joinStrings(types, ",\n"))
+                .addParam(index)
+                .addParam(intToStr(paramCount))
+                .addParam(joinStrings(names, ", "))
+                .expand(paramTables);
+            
+            method.addParam("pmodes" + index + ", ptypes" + index +
+                            ", pnames" + index);
+        }
+
+        method.expand(methods);
+    }
+
+    return TextTmpl(staticMethodTablesTmpl, 4)
+        .addParam(paramTables)
+        .addParam(intToStr(methodCount))
+        .addParam(methods)();
+}
+
+/**
+ * Generate the xcomidl::TypeRef of the base interface.
+ */
+std::string genBaseRef(IInterface const& type, CodeGenOptions const& options)
+{
+    if(type.getBase().isNil())
+    {
+        return "{ 0, 0, 0 }";
+    }
+
+    return genTypeRef(type.getBase(), options);
+}
+
+std::string genGetBase(IInterface const& type, CodeGenOptions const& options)
 {
     if(type.getBase().isNil())
     {
         return "IUnknown base;";
     }
 
-    TextTmpl tmpl(getBaseTmpl, 4);
+    TextTmpl tmpl(options.hashedRegistry ? hashedGetBaseTmpl : getBaseTmpl,
+                  4);
     
     tmpl.addParam(scopedIdlName(type.getBase()));
+
+    if(options.hashedRegistry)
+    {
+        tmpl.addParam(genNameHash(scopedIdlName(type.getBase())));
+    }
+    
     tmpl.addParam(typeDescName(type.getBase()));
 
     return tmpl();
@@ -984,8 +1382,10 @@ std::string genGetBase(IInterface const& type)
 
 } // namespace <unnamed>
 
-InterfaceGen::InterfaceGen(IInterface const& type, RuleBase& rules)
-: type_(type), rules_(rules)
+InterfaceGen::InterfaceGen(IInterface const& type, RuleBase& rules,
+                           CodeGenOptions const& options,
+                           MethodSet const& noThrow)
+: type_(type), rules_(rules), options_(options), noThrow_(noThrow)
 {
 }
 
@@ -998,11 +1398,11 @@ std::string InterfaceGen::genType()
     
     if(type_.getBase().isNil())
     {
-        result += genUnknownClass(type_, rules_);
+        result += genUnknownClass(type_, rules_, options_);
     }
     else
     {
-        result += genItfClass(type_, rules_);
+        result += genItfClass(type_, rules_, options_);
     }
     
     return result;
@@ -1010,7 +1410,7 @@ std::string InterfaceGen::genType()
 
 std::string InterfaceGen::genTie()
 {
-    std::string result(genTieClass(type_, rules_));
+    std::string result(genTieClass(type_, rules_, noThrow_));
     
     result += '\n';
     result += genTieVtbl(type_);
@@ -1020,7 +1420,7 @@ std::string InterfaceGen::genTie()
 
 std::string InterfaceGen::genMethods()
 {
-    return genItfForwarders(type_, rules_);
+    return genItfForwarders(type_, rules_, noThrow_);
 }
 
 std::string InterfaceGen::genMetadataForward()
@@ -1032,14 +1432,40 @@ std::string InterfaceGen::genMetadataForward()
 
 std::string InterfaceGen::genMetadata()
 {
+    if(options_.staticMetadata)
+    {
+        TextTmpl tmpl(staticItfMetadataTmpl, 4);
+        const bool hasMethods = type_.getMethodCount() != 0;
+
+        tmpl.addParam(scopedName(type_.getName().c_str()));
+        tmpl.addParam(genTypeExists(type_.getName().c_str(), options_));
+        
+        if(hasMethods)
+        {
+            tmpl.addParam(genStaticMethodTables(type_, options_));
+        }
+        else
+        {
+            tmpl.skipParam();
+        }
+        
+        tmpl.addParam(type_.getName().c_str());
+        tmpl.addParam(genBaseRef(type_, options_));
+        tmpl.addParam(intToStr(type_.getMethodCount()));
+        tmpl.addParam(hasMethods ? "methods" : "0");
+        tmpl.addParam(scopedName(type_.getName().c_str()));
+        
+        return tmpl();
+    }
+    
     if(type_.getMethodCount() == 0)
     {
 
         TextTmpl tmpl(emptyItfMetadataTmpl, 4);
         
         tmpl.addParam(scopedName(type_.getName().c_str()));
-        tmpl.addParam(type_.getName().c_str());
-        tmpl.addParam(genGetBase(type_));
+        tmpl.addParam(genTypeExists(type_.getName().c_str(), options_));
+        tmpl.addParam(genGetBase(type_, options_));
         tmpl.addParam(type_.getName().c_str());
         tmpl.addParam(scopedName(type_.getName().c_str()));
 
@@ -1051,14 +1477,14 @@ std::string InterfaceGen::genMetadata()
         const std::string maxParam(intToStr(calculateMaxParam(type_)));
         
         tmpl.addParam(scopedName(type_.getName().c_str()));
-        tmpl.addParam(type_.getName().c_str());
-        tmpl.addParam(genGetBase(type_));
+        tmpl.addParam(genTypeExists(type_.getName().c_str(), options_));
+        tmpl.addParam(genGetBase(type_, options_));
         tmpl.addParam(maxParam);
         tmpl.addParam(maxParam);
         tmpl.addParam(maxParam);
         tmpl.addParam(type_.getName().c_str());
         tmpl.addParam(scopedName(type_.getName().c_str()));
-        tmpl.addParam(genMethodMetadatas(type_));
+        tmpl.addParam(genMethodMetadatas(type_, options_));
         
         return tmpl();
     }
@@ -28,6 +28,8 @@
 
 #include <xcom/metadata/Interface.hpp>
 #include "RuleBase.hpp"
+#include "CodeGenOptions.hpp"
+#include "CodeGenPlan.hpp"
 
 /**
  * Code generator for interface's
@@ -35,7 +37,11 @@
 class InterfaceGen
 {
 public:
-    InterfaceGen(xcom::metadata::IInterface const& type, RuleBase& rules);
+    /**
+     * Methods in noThrow are generated as nothrow methods.
+     */
+    InterfaceGen(xcom::metadata::IInterface const& type, RuleBase& rules,
+                 CodeGenOptions const& options, MethodSet const& noThrow);
 
     /**
      * Get the code generated for this interface.
@@ -65,6 +71,8 @@ public:
 private:
     xcom::metadata::IInterface type_;
     RuleBase& rules_;
+    CodeGenOptions const& options_;
+    MethodSet const& noThrow_;
 };
 
 #endif
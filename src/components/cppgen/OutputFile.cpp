@@ -0,0 +1,141 @@
+/**
+ * File    : OutputFile.cpp
+ * Author  : Emir Uner
+ * Summary : Replaces generated files without touching unchanged ones.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "OutputFile.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <atomic>
+#include <stdio.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+/**
+ * Return true if the file exists with exactly the given contents.
+ * The file is read only when its size matches.
+ */
+bool sameContents(std::string const& filename, std::string const& contents)
+{
+    std::string::size_type size = contents.size();
+    struct stat st;
+
+#ifdef _WIN32
+    // Text mode writes each line end as two characters.
+    size += std::count(contents.begin(), contents.end(), '\n');
+#endif
+
+    if(stat(filename.c_str(), &st) != 0 ||
+       static_cast<unsigned long long>(st.st_size) != size)
+    {
+        return false;
+    }
+
+    std::ifstream is(filename.c_str());
+
+    if(!is.is_open())
+    {
+        return false;
+    }
+
+    std::ostringstream buffer;
+    buffer << is.rdbuf();
+
+    return buffer.str() == contents;
+}
+    
+/**
+ * Name of a temporary file next to the given one. The name is unique
+ * among the files written by running xcomidl processes.
+ */
+std::string temporaryName(std::string const& filename)
+{
+    static std::atomic<unsigned int> counter(0);
+    char suffix[48];
+
+#ifdef _WIN32
+    unsigned long pid = _getpid();
+#else
+    unsigned long pid = getpid();
+#endif
+    
+    sprintf(suffix, ".%lu.%u.tmp", pid, counter++);
+
+    return filename + suffix;
+}
+
+/**
+ * Move the file over the target, replacing it in one step.
+ */
+bool replaceFile(std::string const& from, std::string const& to)
+{
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(),
+                       MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+    
+} // namespace <unnamed>
+
+void writeOutput(std::string const& filename, std::string const& contents)
+{
+    if(sameContents(filename, contents))
+    {
+        return;
+    }
+
+    std::string temporary(temporaryName(filename));
+    std::ofstream os(temporary.c_str());
+
+    os.write(contents.data(), contents.size());
+    os.close();
+    
+    if(!os)
+    {
+        remove(temporary.c_str());
+        throw std::runtime_error("cannot write file: " + filename);
+    }
+
+    if(!replaceFile(temporary, filename))
+    {
+        remove(temporary.c_str());
+        throw std::runtime_error("cannot replace file: " + filename);
+    }
+}
@@ -0,0 +1,42 @@
+/**
+ * File    : OutputFile.hpp
+ * Author  : Emir Uner
+ * Summary : Replaces generated files without touching unchanged ones.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_CPPGEN_OUTPUTFILE_HPP_INCLUDED
+#define XCOMIDL_CPPGEN_OUTPUTFILE_HPP_INCLUDED
+
+#include <string>
+
+/**
+ * Write the generated text to the file. If the file already has the
+ * same contents it is not touched, so regenerating an unchanged idl
+ * does not trigger rebuilds. Otherwise the text is written to a
+ * temporary file that is then renamed over the old one, so a reader
+ * sees either the old or the new file and never a partly written one.
+ * Throws runtime_error if the file cannot be written.
+ */
+void writeOutput(std::string const& filename, std::string const& contents);
+
+#endif
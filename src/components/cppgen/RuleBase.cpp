@@ -32,31 +32,9 @@
 
 using namespace xcom::metadata;
 
-namespace
-{
-    
-TypeRules* findExisting(std::vector<TypeRules*>& rules, IType const& type)
-{
-    std::vector<TypeRules*>::iterator it = rules.begin(), end = rules.end();
-    
-    while(it != end)
-    {
-        if(xcom::cast<xcom::IUnknown>((*it)->getSource()).ptr_ == xcom::cast<xcom::IUnknown>(type).ptr_)
-        {
-            return *it;
-        }
-        
-        ++it;
-    }
-
-    return 0;
-}
- 
-} // namespace <unnamed>
-
 TypeRules* RuleBase::forType(IType const& type)
 {
-    TypeRules* rule = findExisting(rules_, type);
+    TypeRules*& rule = rules_[xcom::cast<xcom::IUnknown>(type).ptr_];
     if(rule != 0)
     {
         return rule;
@@ -76,13 +54,11 @@ TypeRules* RuleBase::forType(IType const& type)
     case TypeKind::Enum:
     case TypeKind::Void:
         rule = new BasicTypeRules(type);
-        rules_.push_back(rule);
         return rule;
 
     case TypeKind::String:
     case TypeKind::WString:
         rule = new StringTypeRules(type);
-        rules_.push_back(rule);
         return rule;
 
     case TypeKind::Struct:
@@ -90,12 +66,10 @@ TypeRules* RuleBase::forType(IType const& type)
     case TypeKind::Sequence:
     case TypeKind::Delegate:
         rule = new StructTypeRules(type, this);
-        rules_.push_back(rule);
         return rule;
 
     case TypeKind::Interface:
         rule = new InterfaceRules(xcom::cast<IInterface>(type));
-        rules_.push_back(rule);
         return rule;
         
     default:
@@ -107,11 +81,11 @@ TypeRules* RuleBase::forType(IType const& type)
 
 RuleBase::~RuleBase()
 {
-    std::vector<TypeRules*>::iterator it = rules_.begin(), end = rules_.end();
+    RuleMap::iterator it = rules_.begin(), end = rules_.end();
     
     while(it != end)
     {
-        delete *it;
+        delete it->second;
         ++it;
     }
 }
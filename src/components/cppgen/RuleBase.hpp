@@ -27,10 +27,12 @@
 #define XCOM_TOOLS_IDLTOCPP_RULEBASE_HPP_INCLUDED
 
 #include "TypeRules.hpp"
-#include <vector>
+#include <unordered_map>
 
 /**
  * Manages instances of TypeRules subclasses.
+ * There is one instance per metadata object, found by the address
+ * of the object.
  */
 class RuleBase
 {
@@ -46,7 +48,9 @@ public:
     ~RuleBase();
 
 private:
-    std::vector<TypeRules*> rules_;
+    typedef std::unordered_map<void const*, TypeRules*> RuleMap;
+    
+    RuleMap rules_;
 };
 
 #endif
@@ -56,12 +56,12 @@ BasicTypeRules::BasicTypeRules(xcom::metadata::IType const& source)
     }
 }
 
-std::string BasicTypeRules::normalType()
+std::string const& BasicTypeRules::normalType()
 {
     return name_;
 }
 
-std::string BasicTypeRules::rawType()
+std::string const& BasicTypeRules::rawType()
 {
     return name_;
 }
@@ -95,7 +95,7 @@ std::string BasicTypeRules::asParam(int mode, std::string const& paramName)
     }
 }
 
-std::string BasicTypeRules::returnType()
+std::string const& BasicTypeRules::returnType()
 {
     return name_;
 }
@@ -124,7 +124,7 @@ std::string BasicTypeRules::asRawParam(int mode, std::string const& paramName)
     }
 }
 
-std::string BasicTypeRules::rawReturnType()
+std::string const& BasicTypeRules::rawReturnType()
 {
     return name_;
 }
@@ -147,12 +147,12 @@ StringTypeRules::StringTypeRules(xcom::metadata::IType const& source)
     }
 }
 
-std::string StringTypeRules::normalType()
+std::string const& StringTypeRules::normalType()
 {
     return name_;
 }
 
-std::string StringTypeRules::rawType()
+std::string const& StringTypeRules::rawType()
 {
     return rawName_;
 }
@@ -186,7 +186,7 @@ std::string StringTypeRules::asParam(int mode, std::string const& paramName)
     }
 }
 
-std::string StringTypeRules::returnType()
+std::string const& StringTypeRules::returnType()
 {
     return name_;
 }
@@ -215,7 +215,7 @@ std::string StringTypeRules::asRawParam(int mode, std::string const& paramName)
     }
 }
 
-std::string StringTypeRules::rawReturnType()
+std::string const& StringTypeRules::rawReturnType()
 {
     return rawName_;
 }
@@ -223,7 +223,7 @@ std::string StringTypeRules::rawReturnType()
 // == StructTypeRules methods ================================================
 StructTypeRules::StructTypeRules(xcom::metadata::IType const& source,
                                  RuleBase* rb)
-: TypeRules(source), rb_(rb)
+: TypeRules(source), rb_(rb), complex_(-1)
 {
     switch(source.getKind())
     {
@@ -262,17 +262,28 @@ StructTypeRules::StructTypeRules(xcom::metadata::IType const& source,
     }
 }
   
-std::string StructTypeRules::normalType()
+std::string const& StructTypeRules::normalType()
 {
     return name_;
 }
 
-std::string StructTypeRules::rawType()
+std::string const& StructTypeRules::rawType()
 {
     return rawName_;
 }
 
 bool StructTypeRules::isComplex()
+{
+    // Parts of a type do not change, so it is found once.
+    if(complex_ < 0)
+    {
+        complex_ = findComplex() ? 1 : 0;
+    }
+
+    return complex_ != 0;
+}
+
+bool StructTypeRules::findComplex()
 {
     switch(getSource().getKind())
     {
@@ -328,7 +339,7 @@ std::string StructTypeRules::asParam(int mode, std::string const& paramName)
     }
 }
 
-std::string StructTypeRules::returnType()
+std::string const& StructTypeRules::returnType()
 {
     return name_;
 }
@@ -357,7 +368,7 @@ std::string StructTypeRules::asRawParam(int mode, std::string const& paramName)
     }
 }
 
-std::string StructTypeRules::rawReturnType()
+std::string const& StructTypeRules::rawReturnType()
 {
     return rawName_;
 }
@@ -369,12 +380,12 @@ InterfaceRules::InterfaceRules(xcom::metadata::IInterface const& itf)
 {
 }
   
-std::string InterfaceRules::normalType()
+std::string const& InterfaceRules::normalType()
 {
     return name_;
 }
 
-std::string InterfaceRules::rawType()
+std::string const& InterfaceRules::rawType()
 {
     return rawName_;
 }
@@ -408,7 +419,7 @@ std::string InterfaceRules::asParam(int mode, std::string const& paramName)
     }
 }
 
-std::string InterfaceRules::returnType()
+std::string const& InterfaceRules::returnType()
 {
     return name_;
 }
@@ -437,7 +448,7 @@ std::string InterfaceRules::asRawParam(int mode, std::string const& paramName)
     }
 }
 
-std::string InterfaceRules::rawReturnType()
+std::string const& InterfaceRules::rawReturnType()
 {
     return rawName_;
 }
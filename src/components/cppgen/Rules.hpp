@@ -43,14 +43,14 @@ public:
 
     // Type deduction virtuals' imlementations.
     virtual bool isComplex();
-    virtual std::string normalType();
-    virtual std::string rawType();
+    virtual std::string const& normalType();
+    virtual std::string const& rawType();
     virtual std::string makeParam(int mode, std::string const& paramName);
     virtual std::string asParam(int mode, std::string const& paramName);
-    virtual std::string returnType();
+    virtual std::string const& returnType();
     virtual std::string makeRawParam(int mode, std::string const& paramName);
     virtual std::string asRawParam(int mode, std::string const& paramName);
-    virtual std::string rawReturnType();
+    virtual std::string const& rawReturnType();
     
 private:
     std::string name_;
@@ -69,14 +69,14 @@ public:
     
     // Type deduction virtuals' imlementations.
     virtual bool isComplex();
-    virtual std::string normalType();
-    virtual std::string rawType();
+    virtual std::string const& normalType();
+    virtual std::string const& rawType();
     virtual std::string makeParam(int mode, std::string const& paramName);
     virtual std::string asParam(int mode, std::string const& paramName);
-    virtual std::string returnType();
+    virtual std::string const& returnType();
     virtual std::string makeRawParam(int mode, std::string const& paramName);
     virtual std::string asRawParam(int mode, std::string const& paramName);
-    virtual std::string rawReturnType();
+    virtual std::string const& rawReturnType();
     
 private:
     std::string name_;
@@ -98,19 +98,29 @@ public:
     
     // Type deduction virtuals' imlementations.
     virtual bool isComplex();
-    virtual std::string normalType();
-    virtual std::string rawType();
+    virtual std::string const& normalType();
+    virtual std::string const& rawType();
     virtual std::string makeParam(int mode, std::string const& paramName);
     virtual std::string asParam(int mode, std::string const& paramName);
-    virtual std::string returnType();
+    virtual std::string const& returnType();
     virtual std::string makeRawParam(int mode, std::string const &paramName);
     virtual std::string asRawParam(int mode, std::string const& paramName);
-    virtual std::string rawReturnType();
+    virtual std::string const& rawReturnType();
 
 private:
     RuleBase* rb_;
     std::string name_;
     std::string rawName_;
+
+    /**
+     * 1 if complex, 0 if not, -1 if not found yet.
+     */
+    int complex_;
+
+    /**
+     * Find whether the type is complex by examining its parts.
+     */
+    bool findComplex();
 };
 
 /**
@@ -126,14 +136,14 @@ public:
     
     // Type deduction virtuals' imlementations.
     virtual bool isComplex();
-    virtual std::string normalType();
-    virtual std::string rawType();
+    virtual std::string const& normalType();
+    virtual std::string const& rawType();
     virtual std::string makeParam(int mode, std::string const& paramName);
     virtual std::string asParam(int mode, std::string const& paramName);
-    virtual std::string returnType();
+    virtual std::string const& returnType();
     virtual std::string makeRawParam(int mode, std::string const& paramName);
     virtual std::string asRawParam(int mode, std::string const& paramName);
-    virtual std::string rawReturnType();
+    virtual std::string const& rawReturnType();
 
 private:
     std::string name_;
@@ -33,39 +33,45 @@ using namespace xcom::metadata;
 namespace
 {
 
-char const* adoptTmpl =
+TextTmpl::Source adoptTmpl =
+{
 "static @typeName@ adopt(RawType const& src)\n"
 "{\t\n"
     "@typeName@ result;\n"
     "::memcpy(&result, &src, sizeof(RawType));\n"
     "return result;\v\n"
-"}";
+"}"
+};
     
-char const* sequenceTmpl =
+TextTmpl::Source sequenceTmpl =
+{
 "class @seqName@ : public xcom::SequenceBase<@typename@, @rawTypeName@>\n"
 "{\n"
 "public:\t\n"
     "@adopt@\n"
     "\n"
-    "@seqName@() {}\n"
+    "@ctors@"
     "explicit @seqName@(xcom::Int size)\n"
     ": xcom::SequenceBase<@typename@, @rawTypeName@>(size)\n"
     "{\n"
     "}\v\n"
-"};\n";
+"};\n"
+};
 
-char const* metadataTmpl =
+TextTmpl::Source metadataTmpl =
+{
 "template <>\n"
 "struct TypeDesc<@scopedName@>\n"
 "{\t\n"
     "static void addSelf(IUnknownSeq& types)\n"
     "{\t\n"
-        "if(!typeExists(types, \"@idlName@\"))\n"
+        "if(!@typeExists@)\n"
         "{\t\n"
             "addType(types, xcomCreateSequenceMD(\"@idlName@\", @find@));\v\n"
         "}\v\n"
     "}\v\n"
-"};\n";
+"};\n"
+};
     
 std::string genAdopt(ISequence const& type)
 {
@@ -75,8 +81,9 @@ std::string genAdopt(ISequence const& type)
 
 } // namespace <unnamed>
 
-SequenceGen::SequenceGen(ISequence const& type, RuleBase& rules)
-: type_(type), rules_(rules)
+SequenceGen::SequenceGen(ISequence const& type, RuleBase& rules,
+                         CodeGenOptions const& options)
+: type_(type), rules_(rules), options_(options)
 {
 }
 
@@ -90,7 +97,16 @@ std::string SequenceGen::genType()
     tmpl.addParam(elementRules->rawType());
 
     tmpl.addParam(genAdopt(type_));
-    tmpl.addParam(basePart(type_.getName().c_str()));
+
+    if(options_.cxx11)
+    {
+        tmpl.addParam(genDefaultedMoves(basePart(type_.getName().c_str())));
+    }
+    else
+    {
+        tmpl.addParam(basePart(type_.getName().c_str()) + "() {}\n");
+    }
+    
     tmpl.addParam(basePart(type_.getName().c_str()));
     
     tmpl.addParam(elementRules->normalType());
@@ -105,9 +121,9 @@ std::string SequenceGen::genMetadata()
     TextTmpl tmpl(metadataTmpl, 4);
     
     tmpl.addParam(scopedName(type_.getName().c_str()));
+    tmpl.addParam(genTypeExists(type_.getName().c_str(), options_));
     tmpl.addParam(type_.getName().c_str());
-    tmpl.addParam(type_.getName().c_str());
-    tmpl.addParam(genRawFind(type_.getElementType()));
+    tmpl.addParam(genRawFind(type_.getElementType(), options_));
     
     return tmpl();
 }
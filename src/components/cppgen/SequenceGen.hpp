@@ -28,6 +28,7 @@
 
 #include <xcom/metadata/Sequence.hpp>
 #include "RuleBase.hpp"
+#include "CodeGenOptions.hpp"
 
 /**
  * Code generator for sequence's
@@ -35,7 +36,8 @@
 class SequenceGen
 {
 public:
-    SequenceGen(xcom::metadata::ISequence const& type, RuleBase& rules);
+    SequenceGen(xcom::metadata::ISequence const& type, RuleBase& rules,
+                CodeGenOptions const& options);
 
     /**
      * Get the code generated for this array.
@@ -50,6 +52,7 @@ public:
 private:
     xcom::metadata::ISequence type_;
     RuleBase& rules_;
+    CodeGenOptions const& options_;
 };
 
 #endif
@@ -33,18 +33,23 @@ using namespace xcom::metadata;
 namespace
 {
 
-char const* rawStructTmpl =
+TextTmpl::Source rawStructTmpl =
+{
 "@guidguardbegin@\n"
 "struct @structname@\n"
 "{\t\n"
     "@members@\v\n"
 "};\n"
-"@guidguardend@\n";
+"@guidguardend@\n"
+};
     
-char const* detachLineTmpl =
-"result.@memberName@ = @srcMemberName@@detachCall@;";
+TextTmpl::Source detachLineTmpl =
+{
+"result.@memberName@ = @srcMemberName@@detachCall@;"
+};
 
-char const* detachTmpl =
+TextTmpl::Source detachTmpl =
+{
 "RawType detach()\n"
 "{\t\n"
     "RawType result;\n"
@@ -52,29 +57,37 @@ char const* detachTmpl =
     "@assignments@\n"
     "\n"
     "return result;\v\n"
-"};\n";
+"};\n"
+};
 
-char const* adoptTmpl =
+TextTmpl::Source adoptTmpl =
+{
 "static @structname@ adopt(RawType const& raw)\n"
 "{\t\n"
     "@structname@ result;\n"
     "::memcpy(&result, &raw, sizeof(RawType));\n"
     "return result;\v\n"
-"}\n";
+"}\n"
+};
 
-char const* structTmpl =
+TextTmpl::Source structTmpl =
+{
 "struct @structname@\n"
 "{\t\n"
     "@members@\n"
     "typedef @structname@Data RawType;\n"
+    "@moves@"
     "@detach@\n"
     "@adopt@\v\n"
-"};\n";
+"};\n"
+};
 
-char const* addElementTmpl =
+TextTmpl::Source addElementTmpl =
+{
 "@addElementType@\n"
 "moffsets.push_back(offsetof(@rawTypeName@, @memberName@));\n"
-"mnames.push_back(\"@name@\");\n\n";
+"mnames.push_back(\"@name@\");\n\n"
+};
 
 std::string genStructMembers(IStruct const& type, RuleBase& rules, bool raw)
 {
@@ -168,7 +181,8 @@ std::string genDetach(IStruct const& type, RuleBase& rules)
             assignment.skipParam();
         }
 
-        assignments += assignment() + "\n";
+        assignment.expand(assignments);
+        assignments += '\n';
     }
     
     return TextTmpl(detachTmpl, 4).addParam(assignments)();
@@ -180,13 +194,14 @@ std::string genAdopt(IStruct const& type)
     return TextTmpl(adoptTmpl, 4).addParam(bn).addParam(bn)();
 }
 
-char const* metadataTmpl =
+TextTmpl::Source metadataTmpl =
+{
 "template <>\n"
 "struct TypeDesc<@scopedName@>\n"
 "{\t\n"
     "static void addSelf(IUnknownSeq& types)\n"
     "{\t\n"
-        "if(!typeExists(types, \"@scopedIdlName@\"))\n"
+        "if(!@typeExists@)\n"
         "{\t\n"
             "@mtypes@\n"
             "@mnames@\n"
@@ -196,12 +211,48 @@ char const* metadataTmpl =
                                "mtypes, mnames, moffsets));\v\n"
         "}\v\n"
     "}\v\n"
-"};\n";    
+"};\n"
+};    
+
+TextTmpl::Source staticMetadataTmpl =
+{
+"template <>\n"
+"struct TypeDesc<@scopedName@>\n"
+"{\t\n"
+    "static void addSelf(IUnknownSeq& types)\n"
+    "{\t\n"
+        "if(!@typeExists@)\n"
+        "{\t\n"
+            "static const xcomidl::TypeRef mtypes[@count@] =\n"
+            "{\t\n"
+                "@types@\v\n"
+            "};\n"
+            "static const Char* const mnames[@count@] =\n"
+            "{\t\n"
+                "@names@\v\n"
+            "};\n"
+            "static const Int moffsets[@count@] =\n"
+            "{\t\n"
+                "@offsets@\v\n"
+            "};\n"
+            "static const xcomidl::StructTable table =\n"
+            "{\t\n"
+                "\"@scopedIdlName@\", sizeof(@scopedRawName@), @count@,\n"
+                "mtypes, mnames, moffsets\v\n"
+            "};\n"
+            "\n"
+            "xcomidl::registerStruct(types, table);\v\n"
+        "}\v\n"
+    "}\v\n"
+"};\n"
+};
 
 } // namespace  <unnamed>
 
-StructGen::StructGen(IStruct const& structType, RuleBase& rules)
-: type_(structType), rules_(rules),basename_(basePart(type_.getName().c_str()))
+StructGen::StructGen(IStruct const& structType, RuleBase& rules,
+                     CodeGenOptions const& options)
+: type_(structType), rules_(rules), options_(options),
+  basename_(basePart(type_.getName().c_str()))
 {
 }
 
@@ -216,29 +267,41 @@ std::string StructGen::genType()
         tmpl.addParam(basename());
         tmpl.addParam(genStructMembers(type_, rules_, false));
         tmpl.addParam(basename());
+
+        if(options_.cxx11)
+        {
+            tmpl.addParam(genDefaultedMoves(basename()));
+        }
+        else
+        {
+            tmpl.skipParam();
+        }
+        
         tmpl.addParam(genDetach(type_, rules_));
         tmpl.addParam(genAdopt(type_));
         
-        result += tmpl();
+        tmpl.expand(result);
     }
 
     return result;
 }
 
-char const* mdTypesTmpl =
+TextTmpl::Source mdTypesTmpl =
+{
 "IUnknownRaw* mtypes[@count@] =\n"
 "{\t\n"
     "@types@\v\n"
-"};\n";
+"};\n"
+};
 
-std::string genMDTypes(IStruct const& type)
+std::string genMDTypes(IStruct const& type, CodeGenOptions const& options)
 {
     const int count = type.getMemberCount();
     std::string result;
     
     for(int i = 0; i < count; ++i)
     {
-        result += genRawFind(type.getMemberType(i));
+        result += genRawFind(type.getMemberType(i), options);
         result += ",\n";
     }
     
@@ -247,13 +310,15 @@ std::string genMDTypes(IStruct const& type)
         .addParam(result)();
 }
 
-char const* mdNamesTmpl =
+TextTmpl::Source mdNamesTmpl =
+{
 "static const Char* mnames[@count@] =\n"
 "{\t\n"
     "@names@\v\n"
-"};\n";
+"};\n"
+};
 
-std::string genMDNames(IStruct const& type)
+std::string genMDNameList(IStruct const& type)
 {
     std::string result;
     const int count = type.getMemberCount();
@@ -265,44 +330,97 @@ std::string genMDNames(IStruct const& type)
         result += '"';
         result += ",\n";
     }
-    
+
+    return result;
+}
+
+std::string genMDNames(IStruct const& type)
+{
     return TextTmpl(mdNamesTmpl, 4)
         .addParam(intToStr(type.getMemberCount()))
-        .addParam(result)();
+        .addParam(genMDNameList(type))();
 }
 
-char const* offsetOfTmpl = "offsetof(@rawTypeName@, @memberName@),\n";
+TextTmpl::Source offsetOfTmpl = { "offsetof(@rawTypeName@, @memberName@),\n" };
 
-char const* mdOffsetsTmpl =
+TextTmpl::Source mdOffsetsTmpl =
+{
 "static Int moffsets[@count@] =\n"
 "{\t\n"
     "@offsets@\v\n"
-"};\n";
+"};\n"
+};
 
-std::string genMDOffsets(IStruct const& type, char const* rawName)
+std::string genMDOffsetList(IStruct const& type, char const* rawName)
 {
     std::string result;
     const int count = type.getMemberCount();
 
     for(int i = 0; i < count; ++i)
     {
-        result += TextTmpl(offsetOfTmpl, 4)
+        TextTmpl(offsetOfTmpl, 4)
             .addParam(rawName)
-            .addParam(type.getMemberName(i).c_str())();
+            .addParam(type.getMemberName(i).c_str())
+            .expand(result);
     }
-    
+
+    return result;
+}
+
+std::string genMDOffsets(IStruct const& type, char const* rawName)
+{
     return TextTmpl(mdOffsetsTmpl, 4)
         .addParam(intToStr(type.getMemberCount()))
-        .addParam(result)();
+        .addParam(genMDOffsetList(type, rawName))();
+}
+
+std::string genMDTypeRefs(IStruct const& type, CodeGenOptions const& options)
+{
+    std::string result;
+    const int count = type.getMemberCount();
+    
+    for(int i = 0; i < count; ++i)
+    {
+        result += genTypeRef(type.getMemberType(i), options);
+        result += ",\n";
+    }
+
+    return result;
+}
+
+std::string StructGen::genStaticMetadata()
+{
+    TextTmpl tmpl(staticMetadataTmpl, 4);
+    const std::string count(intToStr(type_.getMemberCount()));
+    const std::string rawName(scopedRawNameOf(type_, rules_));
+    
+    tmpl.addParam(scopedName(type_.getName().c_str()));
+    tmpl.addParam(genTypeExists(type_.getName().c_str(), options_));
+    tmpl.addParam(count);
+    tmpl.addParam(genMDTypeRefs(type_, options_));
+    tmpl.addParam(count);
+    tmpl.addParam(genMDNameList(type_));
+    tmpl.addParam(count);
+    tmpl.addParam(genMDOffsetList(type_, rawName.c_str()));
+    tmpl.addParam(type_.getName().c_str());
+    tmpl.addParam(rawName);
+    tmpl.addParam(count);
+    
+    return tmpl();
 }
 
 std::string StructGen::genMetadata()
 {
+    if(options_.staticMetadata)
+    {
+        return genStaticMetadata();
+    }
+    
     TextTmpl tmpl(metadataTmpl, 4);
     
     tmpl.addParam(scopedName(type_.getName().c_str()));
-    tmpl.addParam(type_.getName().c_str());
-    tmpl.addParam(genMDTypes(type_));
+    tmpl.addParam(genTypeExists(type_.getName().c_str(), options_));
+    tmpl.addParam(genMDTypes(type_, options_));
     tmpl.addParam(genMDNames(type_));
     tmpl.addParam(genMDOffsets(type_, scopedRawNameOf(type_, rules_).c_str()));
     tmpl.addParam(type_.getName().c_str());
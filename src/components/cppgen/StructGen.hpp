@@ -28,6 +28,7 @@
 
 #include <xcom/metadata/Struct.hpp>
 #include "RuleBase.hpp"
+#include "CodeGenOptions.hpp"
 
 /**
  * Code generator for struct's.
@@ -39,7 +40,8 @@ public:
      * A code generator for given structure using the given rule base
      * for members.
      */
-    StructGen(xcom::metadata::IStruct const& structType, RuleBase& rules);
+    StructGen(xcom::metadata::IStruct const& structType, RuleBase& rules,
+              CodeGenOptions const& options);
 
     /**
      * Generate struct definition.
@@ -59,7 +61,13 @@ public:
 private:
     xcom::metadata::IStruct type_;
     RuleBase& rules_;
+    CodeGenOptions const& options_;
     const std::string basename_;
+
+    /**
+     * Generate metadata code that registers constant tables.
+     */
+    std::string genStaticMetadata();
 };
 
 #endif
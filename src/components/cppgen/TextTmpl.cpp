@@ -28,117 +28,264 @@
 
 #include <cassert>
 #include <stdexcept>
+#include <cstring>
 
-TextTmpl::TextTmpl(std::string tmpl, int indentWidth)
-: tmpl_(tmpl), indentWidth_(indentWidth), indentLevel_(0)
+/**
+ * Template split into segments. Text segments refer to the template
+ * characters, field segments carry the index of the field.
+ */
+class TextTmpl::Compiled
+{
+public:
+    enum Kind
+    {
+        Text,
+        Newline,
+        Indent,
+        Outdent,
+        Field
+    };
+    
+    struct Segment
+    {
+        Kind kind;
+        char const* begin;
+        std::size_t length;
+        int field;
+    };
+    
+    std::vector<Segment> segments;
+
+    /**
+     * Field names in order, used in error messages.
+     */
+    std::vector<std::string> fields;
+
+    explicit Compiled(char const* tmpl);
+
+private:
+    void addSegment(Kind kind, char const* begin, std::size_t length);
+};
+
+TextTmpl::Compiled::Compiled(char const* tmpl)
 {
+    char const* ch = tmpl;
+    char const* text = tmpl;
+    
+    while(*ch != '\0')
+    {
+        switch(*ch)
+        {
+        case '@':
+            addSegment(Text, text, ch - text);
+            ++ch;
+            
+            if(*ch == '@')
+            {
+                addSegment(Text, ch, 1);
+                ++ch;
+            }
+            else
+            {
+                char const* name = ch;
+                
+                while(*ch != '\0' && *ch != '@')
+                {
+                    ++ch;
+                }
+                    
+                if(*ch == '\0')
+                {
+                    throw std::runtime_error("unbalanced @ in template");
+                }
+
+                addSegment(Field, name, ch - name);
+                ++ch;
+            }
+
+            text = ch;
+            break;
+        case '\n':
+            addSegment(Text, text, ch - text);
+            addSegment(Newline, ch, 1);
+            text = ++ch;
+            break;
+        case '\t':
+            addSegment(Text, text, ch - text);
+            addSegment(Indent, ch, 1);
+            text = ++ch;
+            break;
+        case '\v':
+            addSegment(Text, text, ch - text);
+            addSegment(Outdent, ch, 1);
+            text = ++ch;
+            break;
+        default:
+            ++ch;
+        }
+    }
+
+    addSegment(Text, text, ch - text);
+}
+
+void TextTmpl::Compiled::addSegment(Kind kind, char const* begin,
+                                    std::size_t length)
+{
+    if(kind == Text && length == 0)
+    {
+        return;
+    }
+
+    // Adjacent text, for example around an escaped @, is merged.
+    if(kind == Text && !segments.empty() && segments.back().kind == Text &&
+       segments.back().begin + segments.back().length == begin)
+    {
+        segments.back().length += length;
+        return;
+    }
+    
+    Segment segment;
+
+    segment.kind = kind;
+    segment.begin = begin;
+    segment.length = length;
+    segment.field = -1;
+
+    if(kind == Field)
+    {
+        segment.field = fields.size();
+        fields.push_back(std::string(begin, length));
+    }
+
+    segments.push_back(segment);
+}
+
+TextTmpl::TextTmpl(Source const& tmpl, int indentWidth)
+: tmpl_(compile(tmpl)), indentWidth_(indentWidth)
+{
+    values_.reserve(tmpl_.fields.size());
 }
 
 TextTmpl::~TextTmpl()
 {
 }
 
+TextTmpl::Compiled const& TextTmpl::compile(Source const& tmpl)
+{
+    Compiled const* result = tmpl.compiled.load(std::memory_order_acquire);
+
+    if(result == 0)
+    {
+        // Compiled templates live as long as the program like the
+        // templates themselves. Of threads compiling the same template
+        // at once, the first to store its result wins.
+        Compiled const* compiled = new Compiled(tmpl.text);
+
+        if(tmpl.compiled.compare_exchange_strong(result, compiled,
+                                                 std::memory_order_acq_rel))
+        {
+            result = compiled;
+        }
+        else
+        {
+            delete compiled;
+        }
+    }
+
+    return *result;
+}
+
 TextTmpl& TextTmpl::addParam(std::string value)
 {
-    values_.push_back(value);
+    if(values_.size() == tmpl_.fields.size())
+    {
+        throw std::runtime_error("excessive number of field values given");
+    }
+    
+    values_.push_back(std::string());
+    values_.back().swap(value);
     return *this;
 }
 
 TextTmpl& TextTmpl::skipParam()
 {
-    values_.push_back("");
-    return *this;
+    return addParam(std::string());
 }
 
-void TextTmpl::appendChar(std::string& target, char ch)
+void TextTmpl::appendValue(std::string& target, std::string const& value,
+                           int& indentLevel) const
 {
-    switch(ch)
+    std::string::size_type pos = 0, control;
+
+    while((control = value.find_first_of("\n\t\v", pos)) != std::string::npos)
     {
-    case '\n':
-        target += ch;
-        target += spaces_;
-        break;
-    case '\t':
-        ++indentLevel_;
-        spaces_ = std::string(indentLevel_ * indentWidth_, ' ');
-        break;
-    case '\v':
-        --indentLevel_;
-        assert(indentLevel_ >= 0);
-        spaces_ = std::string(indentLevel_ * indentWidth_, ' ');
-        break;
-    default:
-        target += ch;
+        target.append(value, pos, control - pos);
+
+        switch(value[control])
+        {
+        case '\n':
+            target += '\n';
+            target.append(indentLevel * indentWidth_, ' ');
+            break;
+        case '\t':
+            ++indentLevel;
+            break;
+        case '\v':
+            --indentLevel;
+            assert(indentLevel >= 0);
+            break;
+        }
+
+        pos = control + 1;
     }
+
+    target.append(value, pos, std::string::npos);
 }
 
-void TextTmpl::appendString(std::string& target, std::string const& str)
+void TextTmpl::expand(std::string& target)
 {
-    std::string::const_iterator val = str.begin(), valEnd = str.end();
-                    
-    while(val != valEnd)
+    if(values_.size() != tmpl_.fields.size())
     {
-        appendChar(target, *val);
-        ++val;
+        throw std::runtime_error("missing field values exist: @" +
+                                 tmpl_.fields[values_.size()] + "@");
     }
-}
-
-std::string TextTmpl::operator()()
-{
-    std::vector<std::string>::const_iterator value = values_.begin(),
-        endValue = values_.end();
     
-    std::string::const_iterator ch = tmpl_.begin(), endCh = tmpl_.end();
+    std::vector<Compiled::Segment>::const_iterator segment =
+        tmpl_.segments.begin(), end = tmpl_.segments.end();
+    int indentLevel = 0;
     
-    std::string result;
-    
-    while(ch != endCh)
+    while(segment != end)
     {
-        if(*ch == '@')
-        {
-            ++ch;
-            if(*ch == '@')
-            {
-                result += '@';
-            }
-            else
-            {
-                if(value != endValue)
-                {
-                    appendString(result, *value);
-                    ++value;
-                
-                    while(ch != endCh && *ch != '@')
-                    {
-                        ++ch;
-                    }
-                    
-                    if(ch == endCh)
-                    {
-                        throw std::runtime_error("unbalanced @ in template");
-                    }
-                    else
-                    {
-                        ++ch;
-                    }
-                }
-                else
-                {
-                    throw std::runtime_error("missing field values exist");
-                }
-            }
-        }
-        else
+        switch(segment->kind)
         {
-            appendChar(result, *ch);
-            ++ch;
+        case Compiled::Text:
+            target.append(segment->begin, segment->length);
+            break;
+        case Compiled::Newline:
+            target += '\n';
+            target.append(indentLevel * indentWidth_, ' ');
+            break;
+        case Compiled::Indent:
+            ++indentLevel;
+            break;
+        case Compiled::Outdent:
+            --indentLevel;
+            assert(indentLevel >= 0);
+            break;
+        case Compiled::Field:
+            appendValue(target, values_[segment->field], indentLevel);
+            break;
         }
+        
+        ++segment;
     }
+}
 
-    if(value != endValue)
-    {
-        throw std::runtime_error("excessive number of field values given");
-    }
+std::string TextTmpl::operator()()
+{
+    std::string result;
+
+    expand(result);
     
     return result;
 }
@@ -29,6 +29,7 @@
 
 #include <vector>
 #include <string>
+#include <atomic>
 
 /**
  * A text template class used to generate text by filling
@@ -37,15 +38,35 @@
  * and a vertical tab decrements indent level.
  * Every newline causes adding a newline to the output following
  * spaces specified by the current indent level.
- * The operator() must be called at most once.
+ * Field values are expanded the same way, so they may change
+ * the indent level too.
+ * A template is split into text, control and field segments the first
+ * time it is used, later uses of the same template only fill fields.
  */
 class TextTmpl
 {
+    class Compiled;
+    
 public:
+    /**
+     * Template text and its compiled form. Templates are defined at
+     * namespace scope with their text only,
+     *
+     *     TextTmpl::Source fooTmpl = { "@name@;\n" };
+     *
+     * and the first use compiles the text and stores it in the source,
+     * so later uses need neither a lock nor a lookup.
+     */
+    struct Source
+    {
+        char const* text;
+        mutable std::atomic<Compiled const*> compiled;
+    };
+    
     /**
      * A text template with given template and indent width.
      */
-    TextTmpl(std::string tmpl, int indentWidth);
+    TextTmpl(Source const& tmpl, int indentWidth);
 
     /**
      * Destructor.
@@ -66,24 +87,28 @@ public:
      * Get the result of template expansion.
      */
     std::string operator()();
-    
-    /**
-     * Appends the character to the string expanding the
-     * control characters as necessary.
-     */
-    void appendChar(std::string& target, char ch);
 
     /**
-     * Appends the whole string using appendChar.
+     * Append the result of template expansion to the target.
      */
-    void appendString(std::string& target, std::string const& str);
+    void expand(std::string& target);
 
 private:
-    std::string tmpl_;
+    Compiled const& tmpl_;
     int indentWidth_;
-    int indentLevel_;
-    std::string spaces_;
     std::vector<std::string> values_;
+
+    /**
+     * Return the compiled form of the template, compiling it if it is
+     * used first.
+     */
+    static Compiled const& compile(Source const& tmpl);
+
+    /**
+     * Append the field value expanding the control characters.
+     */
+    void appendValue(std::string& target, std::string const& value,
+                     int& indentLevel) const;
 };
 
 #endif
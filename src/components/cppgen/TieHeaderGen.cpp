@@ -33,71 +33,25 @@
 
 #include "Helper.hpp"
 #include "IndentedOutput.hpp"
-#include "InterfaceGen.hpp"
 
 using namespace xcom::metadata;
 using namespace xcomidl;
 
-namespace
+void genTieHeader(CodeGenPlan const& plan, Fragments const& fragments,
+                  std::string& output)
 {
-
-/**
- * Returns true if the given hint
- * specifies code generation for an interface.
- */
-inline bool isInterfaceHint(Hint const& hint, Repository const& repo)
-{
-    if(hint.type == CodeGenHint::GenType)
-    {
-        if(repo.findType(hint.parameter.c_str()).getKind() ==
-           TypeKind::Interface)
-        {
-            return true;
-        }
-    }
-    
-    return false;
-}
-    
-/**
- * Get number of interfaces for which code generated.
- */
-int interfaceCount(Repository const& repo, HintSeq const& hints)
-{
-    HintSeq::const_iterator hint = hints.begin(), end = hints.end();
-    int count = 0;
-    
-    while(hint != end)
-    {
-        if(isInterfaceHint(*hint, repo))
-        {
-            ++count;
-        }
-        
-        ++hint;
-    }
-    
-    return count;
-}
-    
-} // namespace <unnamed>
-
-void genTieHeader(Repository const& repo, HintSeq const& hints,
-                  std::ostream& os)
-{
-    if(interfaceCount(repo, hints))
+    if(!plan.getInterfaces().empty())
     {
-        IndentedOutput out(os, 4);
-        RuleBase rules;
+        IndentedOutput out(output, 4);
+        std::vector<PlanStep>::const_iterator step;
         
-        for(HintSeq::const_iterator hint(hints.begin()); hint != hints.end();
-            ++hint)
+        for(step = plan.getSteps().begin(); step != plan.getSteps().end();
+            ++step)
         {
-            switch(hint->type)
+            switch(step->hint)
             {
             case CodeGenHint::EnterNamespace:
-                out.writeLine("namespace " +
-                              std::string(hint->parameter.c_str()) + "\n{\n");
+                out.writeLine("namespace " + step->parameter + "\n{\n");
                 ++out;
                 break;
             case CodeGenHint::LeaveNamespace:
@@ -105,14 +59,10 @@ void genTieHeader(Repository const& repo, HintSeq const& hints,
                 out.writeLine("}\n");
                 break;
             case CodeGenHint::GenType:
-                if(isInterfaceHint(*hint, repo))
+                if(step->kind == TypeKind::Interface)
                 {
                     out.writeLine(
-                        InterfaceGen(
-                            xcom::cast<IInterface>(
-                                repo.findType(hint->parameter.c_str())), rules
-                            ).genTie()
-                        );
+                        fragments[step - plan.getSteps().begin()].tie);
                 }
                 break;
             default: // Ignore other hints.
@@ -27,15 +27,17 @@
 #ifndef XCOMIDL_CPPGEN_TIEHEADERGEN_HPP_INCLUDED
 #define XCOMIDL_CPPGEN_TIEHEADERGEN_HPP_INCLUDED
 
-#include <xcomidl/Repository.hpp>
-#include <xcomidl/ParserTypes.hpp>
+#include "CodeGenPlan.hpp"
+#include "Fragments.hpp"
+
+#include <string>
 
 /**
- * Generate tie header file.
- * If no interface exist no file is produced.
+ * Generate tie header file from the rendered fragments of the plan.
+ * The header text is appended to output.
+ * If no interface exist nothing is produced.
  */
-void genTieHeader(xcomidl::Repository const& repo,
-                  xcomidl::HintSeq const& hints,
-                  std::ostream& os);
+void genTieHeader(CodeGenPlan const& plan, Fragments const& fragments,
+                  std::string& output);
 
 #endif
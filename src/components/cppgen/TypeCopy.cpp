@@ -0,0 +1,214 @@
+/**
+ * File    : TypeCopy.cpp
+ * Author  : Emir Uner
+ * Summary : Copies of types sharing no metadata objects with the originals.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TypeCopy.hpp"
+
+#include <xcom/metadata/Array.hpp>
+#include <xcom/metadata/Enum.hpp>
+#include <xcom/metadata/Exception.hpp>
+#include <xcom/metadata/Sequence.hpp>
+#include <xcom/metadata/Struct.hpp>
+#include <xcom/metadata/Delegate.hpp>
+
+#include <memory>
+
+using namespace xcom::metadata;
+
+IType TypeCopy::copy(IType const& type)
+{
+    IType result = copyType(type);
+
+    while(!shells_.empty())
+    {
+        fill(shells_.begin()->first);
+    }
+
+    return result;
+}
+
+IType TypeCopy::copyType(IType const& type)
+{
+    if(type.isNil())
+    {
+        return 0;
+    }
+
+    int kind = type.getKind();
+
+    if(isBuiltin(kind))
+    {
+        return builtins_.findType(kindAsString(kind));
+    }
+
+    std::string name(xcomidl::typeName(type));
+    CopyMap::const_iterator found = copies_.find(name);
+
+    if(found != copies_.end())
+    {
+        return found->second;
+    }
+
+    IType result;
+
+    switch(kind)
+    {
+    case TypeKind::Exception:
+    case TypeKind::Struct:
+    {
+        std::unique_ptr<StructBase> st;
+
+        if(kind == TypeKind::Exception)
+        {
+            IType base = copyType(xcom::cast<IException>(type).getBase());
+
+            st.reset(new Exception(name.c_str(), xcom::cast<IException>(base),
+                                   -1));
+        }
+        else
+        {
+            st.reset(new Struct(name.c_str(), -1));
+        }
+
+        IStruct original(xcom::cast<IStruct>(type));
+        int count = original.getMemberCount();
+
+        for(int i = 0; i < count; ++i)
+        {
+            st->addMember(original.getMemberName(i).c_str(),
+                          copyType(original.getMemberType(i)));
+        }
+
+        result = st.release();
+        break;
+    }
+    case TypeKind::Array:
+    {
+        IArray original(xcom::cast<IArray>(type));
+
+        result = new xcom::metadata::Array(
+            name.c_str(), copyType(original.getElementType()),
+            original.getSize()
+            );
+        break;
+    }
+    case TypeKind::Sequence:
+        result = new xcom::metadata::Sequence(
+            name.c_str(),
+            copyType(xcom::cast<ISequence>(type).getElementType())
+            );
+        break;
+    case TypeKind::Enum:
+    {
+        IEnum original(xcom::cast<IEnum>(type));
+        std::unique_ptr<Enum> en(new Enum(name.c_str()));
+        int count = original.getElementCount();
+
+        for(int i = 0; i < count; ++i)
+        {
+            en->addElement(original.getElement(i).c_str());
+        }
+
+        result = en.release();
+        break;
+    }
+    case TypeKind::Delegate:
+        result = new xcom::metadata::Delegate(
+            name.c_str(),
+            copyParameters(xcom::cast<IDelegate>(type).getParameters())
+            );
+        break;
+    case TypeKind::Interface:
+    {
+        // Methods may refer to the interface, they are added once the
+        // copy can be found.
+        Shell shell;
+
+        shell.itf = new Interface(name.c_str());
+        shell.original = xcom::cast<IInterface>(type);
+
+        IInterface local(shell.itf);
+
+        result = local;
+        shells_[name] = shell;
+        break;
+    }
+    }
+
+    copies_[name] = result;
+    return result;
+}
+
+std::vector<ParamInfo> TypeCopy::copyParameters(ParamInfoSeq const& params)
+{
+    std::vector<ParamInfo> result;
+    ParamInfoSeq::const_iterator i = params.begin();
+
+    while(i != params.end())
+    {
+        ParamInfo param;
+
+        param.mode = i->mode;
+        param.type = copyType(i->type);
+        param.name = i->name.c_str();
+
+        result.push_back(param);
+        ++i;
+    }
+
+    return result;
+}
+
+void TypeCopy::fill(std::string const& name)
+{
+    ShellMap::iterator i = shells_.find(name);
+
+    if(i == shells_.end())
+    {
+        return;
+    }
+
+    Shell shell = i->second;
+    IInterface base = shell.original.getBase();
+    IInterface baseCopy;
+
+    shells_.erase(i);
+
+    if(!base.isNil())
+    {
+        baseCopy = xcom::cast<IInterface>(copyType(base));
+        fill(xcomidl::typeName(base));
+    }
+
+    shell.itf->satisfyForward(shell.original.getId(), baseCopy);
+
+    int count = shell.original.getMethodCount();
+
+    for(int m = 0; m < count; ++m)
+    {
+        shell.itf->addMethod(shell.original.getMethodName(m).c_str(),
+                             copyParameters(shell.original.getParameters(m)));
+    }
+}
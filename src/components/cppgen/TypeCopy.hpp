@@ -0,0 +1,100 @@
+/**
+ * File    : TypeCopy.hpp
+ * Author  : Emir Uner
+ * Summary : Copies of types sharing no metadata objects with the originals.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_CPPGEN_TYPECOPY_HPP_INCLUDED
+#define XCOMIDL_CPPGEN_TYPECOPY_HPP_INCLUDED
+
+#include <xcomidl/Repository.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Makes copies of types together with every type they refer to,
+ * built-in types included. The copies share no metadata objects with
+ * the originals, so they can be used on a thread while the originals
+ * are used on another. The reference counts of metadata objects are
+ * not safe to change from more than one thread.
+ * Copies of a type are made once, the same copy is returned after.
+ */
+class TypeCopy
+{
+public:
+    /**
+     * Return the copy of the type, nil for a nil type.
+     */
+    xcom::metadata::IType copy(xcom::metadata::IType const& type);
+
+private:
+    typedef std::map<std::string, xcom::metadata::IType> CopyMap;
+    
+    /**
+     * Own built-in types.
+     */
+    xcomidl::Repository builtins_;
+
+    /**
+     * Copies by scoped name.
+     */
+    CopyMap copies_;
+
+    /**
+     * A copied interface whose methods are not added yet.
+     */
+    struct Shell
+    {
+        xcom::metadata::Interface* itf;
+        xcom::metadata::IInterface original;
+    };
+
+    typedef std::map<std::string, Shell> ShellMap;
+
+    /**
+     * Shells by scoped name.
+     */
+    ShellMap shells_;
+
+    /**
+     * Copy the type without filling the interfaces.
+     */
+    xcom::metadata::IType copyType(xcom::metadata::IType const& type);
+
+    /**
+     * Copy the parameters of a method or delegate.
+     */
+    std::vector<xcom::metadata::ParamInfo>
+    copyParameters(xcom::metadata::ParamInfoSeq const& params);
+
+    /**
+     * Fill the shell with the given name and the shells of its bases,
+     * bases first since a derived interface continues the methods of
+     * its base. Does nothing if there is no such shell.
+     */
+    void fill(std::string const& name);
+};
+
+#endif
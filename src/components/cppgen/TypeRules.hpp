@@ -70,12 +70,12 @@ public:
      * Get the string equivalent of the non raw type that is used in C++
      * for this type.
      */
-    virtual std::string normalType() = 0;
+    virtual std::string const& normalType() = 0;
 
     /**
      * Get raw type for this type.
      */
-    virtual std::string rawType() = 0;
+    virtual std::string const& rawType() = 0;
 
     /**
      * Get a string that can be used in the parameter list
@@ -92,7 +92,7 @@ public:
     /**
      * Get return type.
      */
-    virtual std::string returnType() = 0;
+    virtual std::string const& returnType() = 0;
 
     /**
      * Get a string that can be used in the parameter list
@@ -109,7 +109,7 @@ public:
     /**
      * Raw method return type.
      */
-    virtual std::string rawReturnType() = 0;
+    virtual std::string const& rawReturnType() = 0;
 
 private:
     xcom::metadata::IType src_;
@@ -31,19 +31,15 @@ namespace xcomidl
 {
 
 CharBuffer::CharBuffer(std::istream& in)
-: in_(in), lastChar_(std::char_traits<char>::eof()), ungot_(false)
+: in_(&in), pos_(0), end_(0), lastChar_(std::char_traits<char>::eof()),
+  ungot_(false), atEnd_(false)
 {
 }
 
-int CharBuffer::get()
+CharBuffer::CharBuffer(char const* begin, char const* end)
+: in_(0), pos_(begin), end_(end), lastChar_(std::char_traits<char>::eof()),
+  ungot_(false), atEnd_(false)
 {
-    if(ungot_)
-    {
-        ungot_ = false;
-        return lastChar_;
-    }
-    
-    return lastChar_ = in_.get();
 }
 
 void CharBuffer::unget()
@@ -54,7 +50,12 @@ void CharBuffer::unget()
 
 bool CharBuffer::good() const
 {
-    return in_.good();
+    if(in_ == 0)
+    {
+        return !atEnd_;
+    }
+    
+    return in_->good();
 }
  
 } // namespace xcomidl
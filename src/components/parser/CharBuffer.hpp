@@ -34,6 +34,8 @@ namespace xcomidl
             
 /**
  * A character buffer with one character putback capability.
+ * Reads either from a stream or directly from a block of memory,
+ * the latter does not go through the stream buffer for each character.
  */
 class CharBuffer
 {
@@ -43,11 +45,37 @@ public:
      */
     CharBuffer(std::istream& in);
     
+    /**
+     * A character buffer reading the characters in [begin, end).
+     * The memory must stay valid while the buffer is used.
+     */
+    CharBuffer(char const* begin, char const* end);
+    
     /**
      * Return next character.
      * In case of eof return std::char_traits<char>::eof().
      */
-    int get();
+    inline int get()
+    {
+        if(ungot_)
+        {
+            ungot_ = false;
+            return lastChar_;
+        }
+
+        if(in_ == 0)
+        {
+            if(pos_ == end_)
+            {
+                atEnd_ = true;
+                return lastChar_ = std::char_traits<char>::eof();
+            }
+
+            return lastChar_ = (unsigned char)*pos_++;
+        }
+        
+        return lastChar_ = in_->get();
+    }
     
     /**
      * Return the last character read back.
@@ -57,14 +85,18 @@ public:
     void unget();
     
     /**
-     * Return true if last operation succeeded.
+     * Return true if last operation succeeded. Like a stream, a memory
+     * buffer is good until a read hits the end.
      */
     bool good() const;
     
 private:
-    std::istream& in_;
+    std::istream* in_;
+    char const* pos_;
+    char const* end_;
     int lastChar_;
     bool ungot_;
+    bool atEnd_;
 };
  
 } // namespace xcomidl
@@ -34,7 +34,7 @@
 namespace
 {
     
-class ParserImpl : public xcom::Supports<ParserImpl, xcomidl::IParser>, public xcom::RefCounted<ParserImpl>
+class ParserImpl : public xcom::Supports<ParserImpl, xcomidl::IParser2>, public xcom::RefCounted<ParserImpl>
 {
 public:
     bool parse(xcom::StringSeq const& includes,
@@ -42,14 +42,56 @@ public:
                xcomidl::TypeSeq& types,
                xcomidl::HintSeq& hints,
                xcom::StringSeq& messages)
+    {
+        xcom::StringSeq dependencies;
+        
+        return parseWithDependencies(includes, idlFile, types, hints,
+                                     dependencies, messages);
+    }
+    
+    bool parseWithDependencies(xcom::StringSeq const& includes,
+                               xcom::Char const* idlFile,
+                               xcomidl::TypeSeq& types,
+                               xcomidl::HintSeq& hints,
+                               xcom::StringSeq& dependencies,
+                               xcom::StringSeq& messages)
     {
         try
         {
             xcomidl::Repository repo;
-            xcomidl::Parser parser(includes, repo);
+            xcomidl::Parser parser(includes, repo, &cache_);
             
             hints = parser.parse(idlFile);
             types = repo.getTypes();
+            copyDependencies(parser, dependencies);
+        }
+        catch(std::exception& e)
+        {
+            messages.push_back(e.what());
+            return false;
+        }
+        
+        return true;
+    }
+
+    bool parseBuffer(xcom::StringSeq const& includes,
+                     xcom::Char const* idlName,
+                     xcom::Char const* idlContents,
+                     xcomidl::IImportResolver const& resolver,
+                     xcomidl::TypeSeq& types,
+                     xcomidl::HintSeq& hints,
+                     xcom::StringSeq& dependencies,
+                     xcom::StringSeq& messages)
+    {
+        try
+        {
+            xcomidl::Repository repo;
+            xcomidl::Parser parser(includes, repo, &cache_);
+
+            parser.setImportResolver(resolver);
+            hints = parser.parseBuffer(idlName, idlContents);
+            types = repo.getTypes();
+            copyDependencies(parser, dependencies);
         }
         catch(std::exception& e)
         {
@@ -59,6 +101,28 @@ public:
         
         return true;
     }
+
+    void setCacheDirectory(xcom::Char const* directory)
+    {
+        cache_.setDirectory(directory);
+    }
+
+private:
+    // Imports parsed by earlier calls, kept as long as this object.
+    xcomidl::ImportCache cache_;
+
+    static void copyDependencies(xcomidl::Parser const& parser,
+                                 xcom::StringSeq& dependencies)
+    {
+        xcomidl::StringVec deps(parser.getDependencies());
+            
+        dependencies.clear();
+        for(xcomidl::StringVec::const_iterator i = deps.begin();
+            i != deps.end(); ++i)
+        {
+            dependencies.push_back(i->c_str());
+        }
+    }
 };
     
 struct DLLAccess : public xcom::DLLAccessBase
@@ -70,11 +134,12 @@ struct DLLAccess : public xcom::DLLAccessBase
         classes.push_back("xcomidl.Parser");
 
         // Register only interfaces
-        xcom::TypeDesc<xcomidl::IParser>::addSelf(types);
+        xcom::TypeDesc<xcomidl::IParser2>::addSelf(types);
         
         // Add metadata of interfaces that may be returned from QI
         addInterface("xcom.IUnknown");
         addInterface("xcomidl.IParser");
+        addInterface("xcomidl.IParser2");
     }
     
     xcom::IUnknown dllCreateObject(const xcom::Char* classname)
@@ -0,0 +1,87 @@
+/**
+ * File    : FileStamp.hpp
+ * Author  : Emir Uner
+ * Summary : Modification time and size of a file.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_FILESTAMP_HPP_INCLUDED
+#define XCOMIDL_FILESTAMP_HPP_INCLUDED
+
+#include <ctime>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+namespace xcomidl
+{
+
+/**
+ * Modification time and size of a file, compared to find out whether
+ * the file is changed without reading it.
+ */
+struct FileStamp
+{
+    std::time_t mtime;
+
+    /**
+     * Nanoseconds of the modification time, 0 where not available.
+     */
+    long mtimeNsec;
+
+    unsigned long long size;
+};
+
+/**
+ * Stamp of the file examined with stat.
+ */
+inline FileStamp fileStamp(struct stat const& st)
+{
+    FileStamp stamp;
+
+    stamp.mtime = st.st_mtime;
+#if defined(_WIN32)
+    stamp.mtimeNsec = 0;
+#elif defined(__APPLE__)
+    stamp.mtimeNsec = st.st_mtimespec.tv_nsec;
+#else
+    stamp.mtimeNsec = st.st_mtim.tv_nsec;
+#endif
+    stamp.size = st.st_size;
+
+    return stamp;
+}
+
+inline bool operator==(FileStamp const& lhs, FileStamp const& rhs)
+{
+    return lhs.mtime == rhs.mtime && lhs.mtimeNsec == rhs.mtimeNsec &&
+        lhs.size == rhs.size;
+}
+
+inline bool operator!=(FileStamp const& lhs, FileStamp const& rhs)
+{
+    return !(lhs == rhs);
+}
+
+} // namespace xcomidl
+
+#endif
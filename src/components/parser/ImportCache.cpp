@@ -0,0 +1,429 @@
+/**
+ * File    : ImportCache.cpp
+ * Author  : Emir Uner
+ * Summary : Parsed import modules kept across parse calls.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ImportCache.hpp"
+#include "ModuleFile.hpp"
+
+#include <memory>
+#include <set>
+#include <cstdio>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define XCOMIDL_PATH_MAX _MAX_PATH
+#else
+#include <limits.h>
+#define XCOMIDL_PATH_MAX PATH_MAX
+#endif
+
+namespace
+{
+
+using namespace xcomidl;
+
+/**
+ * Add the types of the module and of the modules it imports.
+ * Modules in added are skipped, each module visited is added to it.
+ */
+void addVisibleTypes(ImportCache::Module const* module, TypeMap& visible,
+                     std::set<ImportCache::Module const*>& added)
+{
+    if(!added.insert(module).second)
+    {
+        return;
+    }
+    
+    std::vector<ImportCache::Module const*>::const_iterator i;
+
+    for(i = module->imports.begin(); i != module->imports.end(); ++i)
+    {
+        addVisibleTypes(*i, visible, added);
+    }
+
+    TypeSeq::const_iterator type;
+
+    for(type = module->types.begin(); type != module->types.end(); ++type)
+    {
+        visible[typeName(*type)] = *type;
+    }
+}
+
+} // namespace
+
+namespace xcomidl
+{
+
+ImportCache::ImportCache()
+: parse_(1), running_(0)
+{
+}
+
+ImportCache::~ImportCache()
+{
+    ModuleMap::iterator i = modules_.begin(), end = modules_.end();
+
+    while(i != end)
+    {
+        delete i->second;
+        ++i;
+    }
+
+    std::vector<Module*>::iterator r = retired_.begin();
+
+    while(r != retired_.end())
+    {
+        delete *r;
+        ++r;
+    }
+}
+
+bool ImportCache::identify(std::string const& file, std::string& path,
+                           FileStamp& stamp)
+{
+    struct stat st;
+    char buf[XCOMIDL_PATH_MAX + 1];
+
+    if(stat(file.c_str(), &st) != 0)
+    {
+        return false;
+    }
+
+#ifdef _WIN32
+    if(_fullpath(buf, file.c_str(), sizeof(buf)) == 0)
+#else
+    if(realpath(file.c_str(), buf) == 0)
+#endif
+    {
+        return false;
+    }
+
+    path = buf;
+    stamp = fileStamp(st);
+
+    return true;
+}
+
+void ImportCache::beginParse()
+{
+    ++parse_;
+    ++running_;
+}
+
+void ImportCache::endParse()
+{
+    if(--running_ == 0)
+    {
+        freeRetired();
+    }
+}
+
+void ImportCache::setDirectory(std::string const& directory)
+{
+    directory_ = directory;
+
+    if(!directory_.empty())
+    {
+#ifdef _WIN32
+        _mkdir(directory_.c_str());
+#else
+        mkdir(directory_.c_str(), 0777);
+#endif
+    }
+}
+
+ImportCache::Module const* ImportCache::find(std::string const& path,
+                                             FileStamp const& stamp,
+                                             unsigned long long includes)
+{
+    ModuleMap::const_iterator i = modules_.find(keyOf(path, includes));
+
+    if(i == modules_.end() || !unchanged(i->second, stamp) ||
+       !upToDate(i->second))
+    {
+        return load(path, stamp, includes);
+    }
+
+    return i->second;
+}
+
+ImportCache::Module const* ImportCache::insert(Module* module)
+{
+    if(!directory_.empty())
+    {
+        // A module that cannot be saved is still usable in memory.
+        ModuleFile::write(
+            moduleFileName(keyOf(module->path, module->includes)), *module
+            );
+    }
+
+    return add(module);
+}
+
+ImportCache::Module const* ImportCache::add(Module* module)
+{
+    Module*& slot = modules_[keyOf(module->path, module->includes)];
+
+    if(slot != 0)
+    {
+        retired_.push_back(slot);
+    }
+
+    slot = module;
+    return module;
+}
+
+bool ImportCache::importsCurrent(Module const* module) const
+{
+    std::vector<Module const*>::const_iterator imp = module->imports.begin();
+
+    while(imp != module->imports.end())
+    {
+        ModuleMap::const_iterator i =
+            modules_.find(keyOf((*imp)->path, (*imp)->includes));
+
+        if(i == modules_.end() || i->second != *imp)
+        {
+            return false;
+        }
+
+        ++imp;
+    }
+
+    return true;
+}
+
+void ImportCache::freeRetired()
+{
+    if(retired_.empty())
+    {
+        return;
+    }
+    
+    // Retiring a module may leave its importers behind, repeat until
+    // the current modules import only current modules.
+    bool retiredMore = true;
+
+    while(retiredMore)
+    {
+        retiredMore = false;
+
+        ModuleMap::iterator i = modules_.begin();
+
+        while(i != modules_.end())
+        {
+            if(importsCurrent(i->second))
+            {
+                ++i;
+            }
+            else
+            {
+                retired_.push_back(i->second);
+                modules_.erase(i++);
+                retiredMore = true;
+            }
+        }
+    }
+
+    std::vector<Module*>::iterator r = retired_.begin();
+
+    while(r != retired_.end())
+    {
+        delete *r;
+        ++r;
+    }
+
+    retired_.clear();
+}
+
+std::string ImportCache::keyOf(std::string const& path,
+                               unsigned long long includes)
+{
+    char suffix[20];
+
+    std::sprintf(suffix, "|%016llX", includes);
+
+    return path + suffix;
+}
+
+bool ImportCache::upToDate(Module const* module) const
+{
+    ModuleMap::const_iterator i =
+        modules_.find(keyOf(module->path, module->includes));
+
+    if(i == modules_.end() || i->second != module)
+    {
+        return false;
+    }
+
+    // Shared imports are examined once per parse.
+    if(module->checked == parse_)
+    {
+        return true;
+    }
+    
+    std::vector<Module const*>::const_iterator imp = module->imports.begin();
+
+    while(imp != module->imports.end())
+    {
+        std::string path;
+        FileStamp stamp;
+
+        if(!identify((*imp)->path, path, stamp) || !unchanged(*imp, stamp) ||
+           !upToDate(*imp))
+        {
+            return false;
+        }
+
+        ++imp;
+    }
+
+    module->checked = parse_;
+    return true;
+}
+
+bool ImportCache::unchanged(Module const* module, FileStamp const& stamp)
+{
+    if(module->stamp != stamp)
+    {
+        return false;
+    }
+
+    if(module->stamp.mtime < module->verified)
+    {
+        return true;
+    }
+
+    std::time_t now = std::time(0);
+    SourceFile source;
+
+    if(!source.open(module->path.c_str()) ||
+       contentHash(source.begin(), source.end()) != module->hash)
+    {
+        return false;
+    }
+
+    module->verified = now;
+    return true;
+}
+
+std::string ImportCache::moduleFileName(std::string const& key) const
+{
+    char name[32];
+
+    std::sprintf(name, "/%016llX.xim",
+                 contentHash(key.data(), key.data() + key.size()));
+
+    return directory_ + name;
+}
+
+ImportCache::Module const* ImportCache::load(std::string const& path,
+                                             FileStamp const& stamp,
+                                             unsigned long long includes)
+{
+    ModuleFile file;
+
+    if(directory_.empty() ||
+       !file.open(moduleFileName(keyOf(path, includes))) ||
+       file.getPath() != path || file.getIncludes() != includes)
+    {
+        return 0;
+    }
+
+    std::unique_ptr<Module> module(new Module);
+
+    module->path = path;
+    module->includes = includes;
+    module->stamp = stamp;
+    module->verified = std::time(0);
+
+    {
+        SourceFile source;
+
+        if(!source.open(path.c_str()))
+        {
+            return 0;
+        }
+
+        module->hash = contentHash(source.begin(), source.end());
+    }
+
+    if(module->hash != file.getHash())
+    {
+        return 0;
+    }
+
+    for(int i = 0; i < file.getImportCount(); ++i)
+    {
+        std::string importPath;
+        FileStamp importStamp;
+
+        if(!identify(file.getImportPath(i), importPath, importStamp))
+        {
+            return 0;
+        }
+
+        Module const* imported = find(importPath, importStamp, includes);
+
+        if(imported == 0 || imported->hash != file.getImportHash(i))
+        {
+            return 0;
+        }
+
+        module->imports.push_back(imported);
+    }
+
+    TypeMap visible;
+    TypeSeq builtins(builtins_.getTypes());
+    TypeSeq::const_iterator builtin = builtins.begin();
+
+    while(builtin != builtins.end())
+    {
+        visible[typeName(*builtin)] = *builtin;
+        ++builtin;
+    }
+
+    std::set<Module const*> added;
+    
+    addVisibleTypes(module.get(), visible, added);
+
+    if(!file.readTypes(visible, module->types))
+    {
+        return 0;
+    }
+
+    for(int i = 0; i < file.getNoThrowCount(); ++i)
+    {
+        module->noThrow.push_back(file.getNoThrow(i));
+    }
+
+    return add(module.release());
+}
+
+} // namespace xcomidl
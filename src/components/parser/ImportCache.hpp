@@ -0,0 +1,235 @@
+/**
+ * File    : ImportCache.hpp
+ * Author  : Emir Uner
+ * Summary : Parsed import modules kept across parse calls.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_IMPORTCACHE_HPP_INCLUDED
+#define XCOMIDL_IMPORTCACHE_HPP_INCLUDED
+
+#include <xcomidl/ParserTypes.hpp>
+#include <xcomidl/Repository.hpp>
+
+#include "FileStamp.hpp"
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace xcomidl
+{
+
+/**
+ * Keeps the types of imported idl files so that an idl imported by
+ * many files is parsed once. Modules are keyed by canonical path and
+ * the include paths their imports are found in, and a module is reused
+ * only while neither it nor any of its imports has been modified.
+ * Files are compared by their stamps, and also by their contents while
+ * they were modified in the same second they were read, since another
+ * change in that second may keep the stamp.
+ * If a directory is given modules are also saved there, and a module
+ * missing in memory is loaded from its file while the contents of the
+ * idl file and its imports are the same as when it was saved.
+ */
+class ImportCache
+{
+public:
+    /**
+     * A parsed idl file.
+     */
+    struct Module
+    {
+        /**
+         * Canonical path of the file.
+         */
+        std::string path;
+
+        /**
+         * Hash of the include paths the imports of the file are found in.
+         */
+        unsigned long long includes;
+
+        /**
+         * Stamp of the file when it was parsed.
+         */
+        FileStamp stamp;
+
+        /**
+         * Time before the contents were last found to have the hash.
+         */
+        mutable std::time_t verified;
+
+        /**
+         * Content hash of the file when it was parsed.
+         */
+        unsigned long long hash;
+
+        /**
+         * Types defined in the file, in definition order.
+         */
+        TypeSeq types;
+
+        /**
+         * Methods declared nothrow in the file, as the scoped interface
+         * name and the method name joined by a dot.
+         */
+        std::vector<std::string> noThrow;
+
+        /**
+         * Modules directly imported by the file, in import order.
+         */
+        std::vector<Module const*> imports;
+
+        /**
+         * Number of the last parse the module and its imports were
+         * found unchanged in.
+         */
+        mutable unsigned long checked;
+
+        Module()
+        : includes(0), verified(0), hash(0), checked(0)
+        {
+        }
+    };
+
+    /**
+     * An empty cache.
+     */
+    ImportCache();
+
+    /**
+     * Cleanup.
+     */
+    ~ImportCache();
+
+    /**
+     * Find the canonical path and stamp of the file.
+     * Returns false if the file cannot be examined.
+     */
+    static bool identify(std::string const& file, std::string& path,
+                         FileStamp& stamp);
+
+    /**
+     * Keep module files in the given directory, creating it if needed.
+     * An empty directory keeps modules in memory only.
+     */
+    void setDirectory(std::string const& directory);
+
+    /**
+     * Start a new parse. Files found unchanged in a parse are not
+     * examined again until the next one.
+     * Modules returned by the cache stay valid until endParse.
+     */
+    void beginParse();
+
+    /**
+     * End a parse started with beginParse. Once no parse is running
+     * the replaced modules are freed.
+     */
+    void endParse();
+    
+    /**
+     * Return the module for the given file if it is cached and neither
+     * it nor the modules it imports have changed since, nil otherwise.
+     */
+    Module const* find(std::string const& path, FileStamp const& stamp,
+                       unsigned long long includes);
+
+    /**
+     * Add a parsed module, replacing an older module of the same path
+     * and include paths.
+     * Takes ownership of the module. The module is saved if there is a
+     * directory.
+     */
+    Module const* insert(Module* module);
+
+private:
+    typedef std::map<std::string, Module*> ModuleMap;
+
+    ModuleMap modules_;
+    std::string directory_;
+    unsigned long parse_; // number of the current parse
+    int running_; // parses begun and not ended
+
+    /**
+     * Built-in types for the modules loaded from files.
+     */
+    Repository builtins_;
+
+    /**
+     * Replaced modules, kept while a parse may still refer to them.
+     */
+    std::vector<Module*> retired_;
+
+    /**
+     * Key of the modules of the path parsed with the include paths.
+     */
+    static std::string keyOf(std::string const& path,
+                             unsigned long long includes);
+
+    /**
+     * Return true if the module is the current module of its key
+     * and none of the modules it imports has changed.
+     */
+    bool upToDate(Module const* module) const;
+
+    /**
+     * Return true if the file of the module with the given current
+     * stamp is the file the module was parsed from.
+     */
+    static bool unchanged(Module const* module, FileStamp const& stamp);
+
+    /**
+     * Name of the module file of the given key.
+     */
+    std::string moduleFileName(std::string const& key) const;
+
+    /**
+     * Load the module of the given idl file from the directory.
+     * Returns nil if there is no valid module file.
+     */
+    Module const* load(std::string const& path, FileStamp const& stamp,
+                       unsigned long long includes);
+
+    /**
+     * Replace the module of the same key without saving.
+     */
+    Module const* add(Module* module);
+
+    /**
+     * Return true if every module the module imports is the current
+     * module of its key.
+     */
+    bool importsCurrent(Module const* module) const;
+    
+    /**
+     * Retire the modules that import a replaced module, as they cannot
+     * be up to date again, then free the retired modules.
+     */
+    void freeRetired();
+};
+
+} // namespace xcomidl
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ * File    : IncludeResolver.cpp
+ * Author  : Emir Uner
+ * Summary : Finds imported idl files in the include paths.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "IncludeResolver.hpp"
+#include "ModuleFile.hpp"
+
+#include <stdlib.h>
+
+#ifdef _WIN32
+#define XCOMIDL_PATH_MAX _MAX_PATH
+#else
+#include <limits.h>
+#define XCOMIDL_PATH_MAX PATH_MAX
+#endif
+
+namespace
+{
+
+/**
+ * Find the canonical path of the file. Returns false if it cannot
+ * be found.
+ */
+bool canonicalPath(std::string const& file, std::string& path)
+{
+    char buf[XCOMIDL_PATH_MAX + 1];
+    
+#ifdef _WIN32
+    if(_fullpath(buf, file.c_str(), sizeof(buf)) == 0)
+#else
+    if(realpath(file.c_str(), buf) == 0)
+#endif
+    {
+        return false;
+    }
+
+    path = buf;
+    return true;
+}
+
+} // namespace
+
+namespace xcomidl
+{
+
+IncludeResolver::IncludeResolver(xcom::StringSeq const& paths)
+: paths_(paths)
+{
+    std::string all;
+    xcom::StringSeq::const_iterator i = paths_.begin();
+
+    while(i != paths_.end())
+    {
+        std::string path;
+
+        if(!canonicalPath(i->c_str(), path))
+        {
+            path = i->c_str();
+        }
+
+        all += path;
+        all += '\0';
+        ++i;
+    }
+
+    pathsHash_ = contentHash(all.data(), all.data() + all.size());
+}
+
+IncludeResolver::File const* IncludeResolver::find(std::string const& name)
+{
+    std::pair<NameMap::iterator, bool> entry =
+        names_.insert(NameMap::value_type(name, File()));
+    File& file = entry.first->second;
+
+    if(entry.second && !search(name, file))
+    {
+        file.path.clear();
+    }
+
+    return file.path.empty() ? 0 : &file;
+}
+
+unsigned long long IncludeResolver::getPathsHash() const
+{
+    return pathsHash_;
+}
+
+bool IncludeResolver::search(std::string const& name, File& file)
+{
+    xcom::StringSeq::const_iterator i = paths_.begin(), end = paths_.end();
+    struct stat st;
+    
+    while(i != end)
+    {
+        file.path = std::string(i->c_str()) + "/" + name;
+        
+        if(stat(file.path.c_str(), &st) == 0 && (st.st_mode & S_IFMT) != S_IFDIR)
+        {
+            break;
+        }
+
+        ++i;
+    }
+
+    if(i == end)
+    {
+        return false;
+    }
+
+    file.stamp = fileStamp(st);
+
+#ifdef _WIN32
+    // There are no inode numbers, the canonical path is the identity.
+    file.identified = canonicalPath(file.path, file.identity);
+#else
+    FileId id(st.st_dev, st.st_ino);
+    IdentityMap::const_iterator known = identities_.find(id);
+
+    if(known != identities_.end())
+    {
+        file.identity = known->second;
+        file.identified = true;
+    }
+    else
+    {
+        file.identified = canonicalPath(file.path, file.identity);
+
+        if(file.identified)
+        {
+            identities_[id] = file.identity;
+        }
+    }
+#endif
+
+    if(!file.identified)
+    {
+        file.identity = file.path;
+    }
+    
+    return true;
+}
+
+} // namespace xcomidl
@@ -0,0 +1,124 @@
+/**
+ * File    : IncludeResolver.hpp
+ * Author  : Emir Uner
+ * Summary : Finds imported idl files in the include paths.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_INCLUDERESOLVER_HPP_INCLUDED
+#define XCOMIDL_INCLUDERESOLVER_HPP_INCLUDED
+
+#include <xcom/Types.hpp>
+
+#include "FileStamp.hpp"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace xcomidl
+{
+
+/**
+ * Finds imported idl files in the include paths. The result of each
+ * name is remembered, including names that are not found, so every
+ * include path is examined at most once for a name. Files are
+ * examined with stat only and are not opened.
+ * The same file reached through different names gets the same
+ * identity, the canonical path of the first name that reached it.
+ */
+class IncludeResolver
+{
+public:
+    /**
+     * A file found in the include paths.
+     */
+    struct File
+    {
+        /**
+         * Path of the file in the include path it is found.
+         */
+        std::string path;
+
+        /**
+         * Canonical path of the file, or path if it cannot be found.
+         */
+        std::string identity;
+
+        /**
+         * Stamp of the file when it is found.
+         */
+        FileStamp stamp;
+
+        /**
+         * False if the canonical path cannot be found.
+         */
+        bool identified;
+    };
+    
+    /**
+     * Resolver searching the given include paths in order.
+     */
+    IncludeResolver(xcom::StringSeq const& paths);
+
+    /**
+     * Return the file with the given name in the first include path
+     * containing it, nil if no include path contains it.
+     */
+    File const* find(std::string const& name);
+
+    /**
+     * Hash of the canonical include paths in search order. Names are
+     * found in the same files only by resolvers of the same hash.
+     */
+    unsigned long long getPathsHash() const;
+
+private:
+    typedef std::unordered_map<std::string, File> NameMap;
+    typedef std::pair<unsigned long long, unsigned long long> FileId;
+    typedef std::map<FileId, std::string> IdentityMap;
+    
+    xcom::StringSeq paths_;
+    unsigned long long pathsHash_;
+
+    /**
+     * Files by name. Names that are not found map to a file with
+     * an empty path.
+     */
+    NameMap names_;
+
+    /**
+     * Canonical paths by device and inode number.
+     */
+    IdentityMap identities_;
+
+    /**
+     * Search the include paths for the name and fill the file.
+     * Returns false if the name is not found.
+     */
+    bool search(std::string const& name, File& file);
+};
+
+} // namespace xcomidl
+
+#endif
@@ -27,6 +27,8 @@
 #include "Lexer.hpp"
 
 #include <ctype.h>
+#include <stdio.h>
+#include <string.h>
 
 #include <cassert>
 #include <sstream>
@@ -58,11 +60,11 @@ namespace
     }
 
     /**
-     * Reads an invalid token until finding a separator character.
+     * Reads an invalid token until finding a separator character
+     * and appends it to result.
      */
-    inline std::string consumeInvalid(CharBuffer& in)
+    inline void consumeInvalid(CharBuffer& in, std::string& result)
     {
-        std::string result;
         int ch;
         
         while((ch = in.get()) != std::char_traits<char>::eof())
@@ -75,8 +77,6 @@ namespace
             
             result += ch;
         }
-
-        return result;
     }
     
     /**
@@ -84,11 +84,11 @@ namespace
      * Integer token must be terminated by a separatorChar.
      * In case of erroneous integer return false and up to first separator
      * write the token string to invalid parameter.
+     * The strnum parameter is used as scratch space.
      */
     inline bool consumePositiveInteger(CharBuffer& in, int& result,
-                                       std::string& invalid)
+                                       std::string& strnum)
     {
-        std::string strnum;
         int ch;
         
         while((ch = in.get()) != std::char_traits<char>::eof())
@@ -105,7 +105,7 @@ namespace
             else
             {
                 in.unget();
-                invalid = strnum + consumeInvalid(in);
+                consumeInvalid(in, strnum);
                 return false;
             }
         }
@@ -120,9 +120,10 @@ namespace
      * Actually contains even ::'s and the place of ::
      * is not at end.
      */
-    bool validIdentifier(std::string const& id)
+    bool validIdentifier(char const* id, std::size_t length)
     {
-        std::string::const_iterator i = id.begin(), end = id.end();
+        char const* i = id;
+        char const* end = id + length;
         
         while(i != end)
         {
@@ -159,14 +160,14 @@ namespace
      * Reads a string literal whose opening quote is read.
      * Returns false if an error occurs before string literal completes.
      */
-    bool readStringLiteral(std::istream& in, int& lineNo, std::string& result)
+    bool readStringLiteral(CharBuffer& in, int& lineNo, std::string& result)
     {
         int ch;
         
         while(true)
         {
             ch = in.get();
-            if(in.fail() || in.eof())
+            if(ch == std::char_traits<char>::eof())
             {
                 return false;
             }
@@ -194,12 +195,12 @@ namespace
      * and the invalid input in result otherwise returns true and
      * result is empty.
      */
-    bool readComment(std::istream& in, int& lineNo, std::string& result)
+    bool readComment(CharBuffer& in, int& lineNo, std::string& result)
     {
         int ch;
         
         ch = in.get();
-        if(!in.fail())
+        if(ch != std::char_traits<char>::eof())
         {
             if(ch == '/')
             {
@@ -224,16 +225,14 @@ namespace
                     if(ch == '*')
                     {
                         ch = in.get();
-                        if(!in.fail() && ch != std::char_traits<char>::eof())
-                        {
-                            result += ch;
-                        }
-                        
-                        if(in.fail())
+                        if(ch == std::char_traits<char>::eof())
                         {
                             return false;
                         }
-                        else if(ch == '/')
+
+                        result += ch;
+
+                        if(ch == '/')
                         {
                             result = "";
                             return true;
@@ -265,11 +264,11 @@ namespace
 
     /**
      * Tries to read an identifier whose first letter is read.
+     * The rest of the identifier is appended to result.
      */
     bool consumeIdentifierOrKeyword(CharBuffer& in, std::string& result)
     {
         int ch;
-        result = "";
         
         while((ch = in.get()) != std::char_traits<char>::eof())
         {
@@ -301,131 +300,145 @@ namespace
     }
 
     /**
-     * Token from identifier of keyword string.
+     * A reserved word and the token type it stands for.
      */
-    Token tokenFromIdentifier(std::string id, int lineNo)
+    struct Keyword
     {
-        if(id == "void")
-        {
-            return Token(TokenType::Void, lineNo);
-        }
-        else if(id == "namespace")
-        {
-            return Token(TokenType::Namespace, lineNo);
-        }
-        else if(id == "interface")
-        {
-            return Token(TokenType::Interface, lineNo);
-        }
-        else if(id == "array")
-        {
-            return Token(TokenType::Array, lineNo);
-        }
-        else if(id == "sequence")
-        {
-            return Token(TokenType::Sequence, lineNo);
-        }
-        else if(id == "struct")
-        {
-            return Token(TokenType::Struct, lineNo);
-        }
-        else if(id == "extends")
-        {
-            return Token(TokenType::Extends, lineNo);
-        }
-        else if(id == "boolean")
-        {
-            return Token(TokenType::Bool, lineNo);
-        }
-        else if(id == "octet")
-        {
-            return Token(TokenType::Octet, lineNo);
-        }
-        else if(id == "short")
-        {
-            return Token(TokenType::Short, lineNo);
-        }
-        else if(id == "int")
-        {
-            return Token(TokenType::Int, lineNo);
-        }
-        else if(id == "long")
-        {
-            return Token(TokenType::Long, lineNo);
-        }
-        else if(id == "char")
-        {
-            return Token(TokenType::Char, lineNo);
-        }
-        else if(id == "wchar")
-        {
-            return Token(TokenType::WChar, lineNo);
-        }
-        else if(id == "exception")
-        {
-            return Token(TokenType::Exception, lineNo);
-        }
-        else if(id == "float")
-        {
-            return Token(TokenType::Float, lineNo);
-        }
-        else if(id == "double")
-        {
-            return Token(TokenType::Double, lineNo);
-        }
-        else if(id == "in")
-        {
-            return Token(TokenType::In, lineNo);
-        }
-        else if(id == "out")
-        {
-            return Token(TokenType::Out, lineNo);
-        }
-        else if(id == "inout")
-        {
-            return Token(TokenType::InOut, lineNo);
-        }
-        else if(id == "string")
-        {
-            return Token(TokenType::String, lineNo);
-        }
-        else if(id == "wstring")
-        {
-            return Token(TokenType::WString, lineNo);
-        }
-        else if(id == "enum")
-        {
-            return Token(TokenType::Enum, lineNo);
-        }
-        else if(id == "import")
-        {
-            return Token(TokenType::Import, lineNo);
-        }
-        else if(id == "nothrow")
-        {
-            return Token(TokenType::NoThrow, lineNo);
-        }
-        else if(id == "any")
+        char const* name;
+        TokenTypeEnum type;
+    };
+
+    Keyword const keywords[] =
+    {
+        { "void", TokenType::Void },
+        { "namespace", TokenType::Namespace },
+        { "interface", TokenType::Interface },
+        { "array", TokenType::Array },
+        { "sequence", TokenType::Sequence },
+        { "struct", TokenType::Struct },
+        { "extends", TokenType::Extends },
+        { "boolean", TokenType::Bool },
+        { "octet", TokenType::Octet },
+        { "short", TokenType::Short },
+        { "int", TokenType::Int },
+        { "long", TokenType::Long },
+        { "char", TokenType::Char },
+        { "wchar", TokenType::WChar },
+        { "exception", TokenType::Exception },
+        { "float", TokenType::Float },
+        { "double", TokenType::Double },
+        { "in", TokenType::In },
+        { "out", TokenType::Out },
+        { "inout", TokenType::InOut },
+        { "string", TokenType::String },
+        { "wstring", TokenType::WString },
+        { "enum", TokenType::Enum },
+        { "import", TokenType::Import },
+        { "nothrow", TokenType::NoThrow },
+        { "any", TokenType::Any },
+        { "delegate", TokenType::Delegate }
+    };
+
+    /**
+     * Number of slots in the keyword hash table, must be a power of 2.
+     */
+    std::size_t const keywordSlots = 64;
+    
+    /**
+     * Hash of a non-empty identifier using its length and first and last
+     * characters. The multipliers were chosen so that no two keywords
+     * fall into the same slot; keywordTable asserts this.
+     */
+    inline std::size_t keywordHash(char const* id, std::size_t length)
+    {
+        return (length +
+                41 * (unsigned char)id[0] +
+                11 * (unsigned char)id[length - 1]) & (keywordSlots - 1);
+    }
+
+    /**
+     * Perfect hash table of the keywords, empty slots have nil name.
+     */
+    struct KeywordTable
+    {
+        Keyword slots[keywordSlots];
+        std::size_t lengths[keywordSlots];
+        
+        KeywordTable()
         {
-            return Token(TokenType::Any, lineNo);
+            for(std::size_t i = 0; i < keywordSlots; ++i)
+            {
+                slots[i].name = 0;
+                slots[i].type = TokenType::Identifier;
+                lengths[i] = 0;
+            }
+
+            std::size_t const count = sizeof(keywords) / sizeof(keywords[0]);
+            
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                std::size_t length = strlen(keywords[i].name);
+                std::size_t slot = keywordHash(keywords[i].name, length);
+                
+                assert(slots[slot].name == 0);
+                slots[slot] = keywords[i];
+                lengths[slot] = length;
+            }
         }
-        else if(id == "delegate")
+    };
+
+    /**
+     * Token from identifier of keyword string.
+     * Identifiers are interned into the given symbol table.
+     *
+     * @pre length > 0
+     */
+    Token tokenFromIdentifier(char const* id, std::size_t length, int lineNo,
+                              SymbolTable& symbols)
+    {
+        TokenTypeEnum type = Lexer::keywordType(id, length);
+        
+        if(type != TokenType::Identifier)
         {
-            return Token(TokenType::Delegate, lineNo);
+            return Token(type, lineNo);
         }
-        else if(validIdentifier(id))
+        else if(validIdentifier(id, length))
         {
-            return Token(TokenType::Identifier, lineNo, id.c_str());
+            return Token(TokenType::Identifier, lineNo,
+                         symbols.intern(id, length));
         }
         else
         {
-            return Token(TokenType::Invalid, lineNo, id.c_str());
+            return Token(TokenType::Invalid, lineNo,
+                         symbols.intern(id, length));
         }
     }
 } // namespace <unnamed>
 
-Lexer::Lexer(std::istream& in, std::string filename)
-: inStream_(in), in_(in), filename_(filename), lineNo_(1), pushedBack_(false),
+TokenTypeEnum Lexer::keywordType(char const* id, std::size_t length)
+{
+    static KeywordTable const table;
+        
+    std::size_t slot = keywordHash(id, length);
+        
+    if(table.lengths[slot] == length &&
+       memcmp(table.slots[slot].name, id, length) == 0)
+    {
+        return table.slots[slot].type;
+    }
+
+    return TokenType::Identifier;
+}
+
+Lexer::Lexer(std::istream& in, std::string filename, SymbolTable& symbols)
+: in_(in), symbols_(symbols), filename_(filename), lineNo_(1), pushedBack_(false),
+  token_(Token::invalidToken())
+{
+}
+
+Lexer::Lexer(char const* begin, char const* end, std::string filename,
+             SymbolTable& symbols)
+: in_(begin, end), symbols_(symbols), filename_(filename), lineNo_(1), pushedBack_(false),
   token_(Token::invalidToken())
 {
 }
@@ -569,33 +582,37 @@ Token Lexer::getNextToken()
 
         case '"':
         {
-            std::string sl;
+            scratch_ = '"';
             
-            if(readStringLiteral(inStream_, lineNo_, sl))
+            if(readStringLiteral(in_, lineNo_, scratch_))
             {
                 return token_ = Token(TokenType::StringLiteral, lineNo_,
-                                      sl.c_str());
+                                      symbols_.intern(scratch_.data() + 1,
+                                                      scratch_.size() - 1));
             }
             else
             {
                 return token_ = Token(TokenType::Invalid, lineNo_,
-                                      ("\"" + sl).c_str());
+                                      symbols_.intern(scratch_.data(),
+                                                      scratch_.size()));
             }
         }
         break;
         
         case '/':
         {
-            std::string sl;
+            scratch_.clear();
             
-            if(readComment(inStream_, lineNo_, sl))
+            if(readComment(in_, lineNo_, scratch_))
             {
                 continue;
             }
             else
             {
+                scratch_.insert(scratch_.begin(), '/');
                 return token_ = Token(TokenType::Invalid, lineNo_,
-                                      ("/" + sl).c_str());
+                                      symbols_.intern(scratch_.data(),
+                                                      scratch_.size()));
             }
         }
         break;
@@ -611,36 +628,42 @@ Token Lexer::getNextToken()
         case '9':
         {
             int result;
-            std::string offending;
             
+            scratch_.clear();
             in_.unget();
-            if(consumePositiveInteger(in_, result, offending))
+            if(consumePositiveInteger(in_, result, scratch_))
             {
-                return token_ = Token(TokenType::PositiveInt, lineNo_, result);
+                char buf[20];
+                int length = sprintf(buf, "%d", result);
+                
+                return token_ = Token(TokenType::PositiveInt, lineNo_, result,
+                                      symbols_.intern(buf, length));
             }
             else
             {
                 return token_ = Token(TokenType::Invalid, lineNo_,
-                                      offending.c_str());
+                                      symbols_.intern(scratch_.data(),
+                                                      scratch_.size()));
             }
         }
         break;
 
         default:
         {
-            std::string result;
+            scratch_ = (char)ch;
             
-            if(consumeIdentifierOrKeyword(in_, result))
+            if(consumeIdentifierOrKeyword(in_, scratch_))
             {
-                return token_ = tokenFromIdentifier((char)ch + result,
-                                                    lineNo_);
+                return token_ = tokenFromIdentifier(scratch_.data(),
+                                                    scratch_.size(),
+                                                    lineNo_, symbols_);
             }
             
             // If we are here an unrecognized input is present.
-            return token_ = Token(
-                TokenType::Invalid, lineNo_,
-                ((char)ch + result + consumeInvalid(in_)).c_str()
-                );
+            consumeInvalid(in_, scratch_);
+            return token_ = Token(TokenType::Invalid, lineNo_,
+                                  symbols_.intern(scratch_.data(),
+                                                  scratch_.size()));
         }
         break;
         
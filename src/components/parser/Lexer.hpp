@@ -42,8 +42,16 @@ class Lexer
 public:
     /**
      * Construct a lexer that uses the given stream as source.
+     * Token text is interned into the given symbol table.
      */
-    Lexer(std::istream& in, std::string filename);
+    Lexer(std::istream& in, std::string filename, SymbolTable& symbols);
+
+    /**
+     * Construct a lexer that scans the characters in [begin, end).
+     * The memory must stay valid while the lexer is used.
+     */
+    Lexer(char const* begin, char const* end, std::string filename,
+          SymbolTable& symbols);
     
     /**
      * Get next token.
@@ -112,16 +120,17 @@ public:
     }
 
     /**
-     * Get a reference to the input stream of the lexer.
+     * Return the keyword token type of the identifier or
+     * TokenType::Identifier if it is not a keyword.
+     *
+     * @pre length > 0
      */
-    inline std::istream const& getStream() const
-    {
-        return inStream_;
-    }
-    
+    static TokenTypeEnum keywordType(char const* id, std::size_t length);
+
 private:
-    std::istream& inStream_;
     CharBuffer in_;
+    SymbolTable& symbols_;
+    std::string scratch_;
     std::string filename_;
     int lineNo_;
     bool pushedBack_;
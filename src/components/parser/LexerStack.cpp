@@ -29,6 +29,11 @@
 namespace xcomidl
 {
 
+LexerStack::LexerStack(SymbolTable& symbols)
+: symbols_(symbols)
+{
+}
+
 LexerStack::~LexerStack()
 {
     clear();
@@ -36,7 +41,33 @@ LexerStack::~LexerStack()
 
 void LexerStack::push(std::istream* in, std::string file)
 {
-    stack_.push(new Lexer(*in, file));
+    Entry entry;
+    
+    entry.lexer = new Lexer(*in, file, symbols_);
+    entry.stream = in;
+    entry.source = 0;
+    stack_.push(entry);
+}
+
+void LexerStack::push(SourceFile* source, std::string file)
+{
+    Entry entry;
+    
+    entry.lexer = new Lexer(source->begin(), source->end(), file,
+                            symbols_);
+    entry.stream = 0;
+    entry.source = source;
+    stack_.push(entry);
+}
+
+void LexerStack::push(char const* begin, char const* end, std::string file)
+{
+    Entry entry;
+    
+    entry.lexer = new Lexer(begin, end, file, symbols_);
+    entry.stream = 0;
+    entry.source = 0;
+    stack_.push(entry);
 }
 
 bool LexerStack::empty() const
@@ -46,13 +77,16 @@ bool LexerStack::empty() const
     
 Lexer* LexerStack::top()
 {
-    return stack_.top();
+    return stack_.top().lexer;
 }
 
 void LexerStack::pop()
 {
-    delete &stack_.top()->getStream();
-    delete stack_.top();
+    Entry& entry = stack_.top();
+    
+    delete entry.lexer;
+    delete entry.stream;
+    delete entry.source;
     stack_.pop();
 }
 
@@ -65,8 +99,7 @@ void LexerStack::clear()
 {
     while(!stack_.empty())
     {
-        delete stack_.top();
-        stack_.pop();
+        pop();
     }
 }
 
@@ -28,6 +28,7 @@
 #define XCOMIDL_LEXERSTACK_HPP_INCLUDED
 
 #include "Lexer.hpp"
+#include "SourceFile.hpp"
 
 #include <stack>
 #include <istream>
@@ -36,7 +37,7 @@ namespace xcomidl
 {
 
 /**
- * Holds a stack of lexers and associated streams with them.
+ * Holds a stack of lexers and associated sources with them.
  * This is a specialized class with an irregular interface, note push and top.
  * The top returns reference to dynamically allocated regions and when
  * an element popped its memory is deallocated.
@@ -44,16 +45,33 @@ namespace xcomidl
 class LexerStack
 {
 public:
+    /**
+     * Lexers pushed onto the stack intern their tokens into symbols.
+     */
+    explicit LexerStack(SymbolTable& symbols);
+    
     /**
      * Cleanup.
      */
     ~LexerStack();
     
     /**
-     * Push a new lexer.
+     * Push a new lexer reading from a stream.
      * Owns the stream object.
      */
     void push(std::istream* in, std::string file);
+
+    /**
+     * Push a new lexer scanning the contents of a loaded file.
+     * Owns the source object.
+     */
+    void push(SourceFile* source, std::string file);
+
+    /**
+     * Push a new lexer scanning the characters in [begin, end).
+     * The memory is not owned and must outlive the lexer.
+     */
+    void push(char const* begin, char const* end, std::string file);
     
     /**
      * Is empty.
@@ -83,7 +101,18 @@ public:
     void clear();
     
 private:
-    std::stack<Lexer*> stack_;
+    /**
+     * A lexer and the source object it reads from, if owned.
+     */
+    struct Entry
+    {
+        Lexer* lexer;
+        std::istream* stream;
+        SourceFile* source;
+    };
+    
+    SymbolTable& symbols_;
+    std::stack<Entry> stack_;
 };
     
 } // namespace xcomidl
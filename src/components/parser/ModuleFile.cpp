@@ -0,0 +1,881 @@
+/**
+ * File    : ModuleFile.cpp
+ * Author  : Emir Uner
+ * Summary : Binary form of parsed idl modules kept on disk.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ModuleFile.hpp"
+
+#include <xcomidl/Repository.hpp>
+
+#include <xcom/metadata/Array.hpp>
+#include <xcom/metadata/Enum.hpp>
+#include <xcom/metadata/Exception.hpp>
+#include <xcom/metadata/Interface.hpp>
+#include <xcom/metadata/Sequence.hpp>
+#include <xcom/metadata/Struct.hpp>
+#include <xcom/metadata/Delegate.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <algorithm>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+using namespace xcomidl;
+using namespace xcom::metadata;
+
+namespace
+{
+
+char const MAGIC[8] = { 'X', 'I', 'D', 'L', 'M', 'O', 'D', '\0' };
+
+/**
+ * Changed whenever the layout of the file changes.
+ */
+unsigned int const VERSION = 3;
+
+/**
+ * Written as is, reads differently on a machine of other byte order.
+ */
+unsigned int const ORDER_MARK = 0x01020304;
+
+/**
+ * Stands for a nil type reference.
+ */
+unsigned int const NONE = 0xffffffff;
+
+/**
+ * Number of words a GUID takes in a record.
+ */
+unsigned int const GUID_WORDS = (sizeof(xcom::GUID) + 3) / 4;
+
+/**
+ * Builds the type records and the string table of a module file.
+ * Equal strings are stored once.
+ */
+class Writer
+{
+public:
+    std::vector<unsigned int> words;
+    std::vector<unsigned int> records;
+    std::string strings;
+
+    /**
+     * Offset of the string in the string table.
+     */
+    unsigned int intern(std::string const& str)
+    {
+        StringMap::const_iterator i = offsets_.find(str);
+
+        if(i != offsets_.end())
+        {
+            return i->second;
+        }
+
+        unsigned int offset = strings.size();
+
+        strings.append(str.c_str(), str.size() + 1);
+        offsets_[str] = offset;
+
+        return offset;
+    }
+
+    void put(unsigned int word)
+    {
+        words.push_back(word);
+    }
+
+    void putString(std::string const& str)
+    {
+        put(intern(str));
+    }
+
+    void putType(IType const& type)
+    {
+        put(type.isNil() ? NONE : intern(typeName(type)));
+    }
+
+    void putParameters(ParamInfoSeq const& params)
+    {
+        put(params.size());
+
+        ParamInfoSeq::const_iterator i = params.begin();
+
+        while(i != params.end())
+        {
+            put(i->mode);
+            putType(i->type);
+            putString(i->name.c_str());
+            ++i;
+        }
+    }
+
+    void putRecord(IType const& type);
+
+private:
+    typedef std::map<std::string, unsigned int> StringMap;
+
+    StringMap offsets_;
+};
+
+void Writer::putRecord(IType const& type)
+{
+    records.push_back(words.size());
+    put(type.getKind());
+    putString(typeName(type));
+
+    switch(type.getKind())
+    {
+    case TypeKind::Exception:
+    {
+        IException exc(xcom::cast<IException>(type));
+        putType(exc.getBase());
+    }
+    // Fall through for members.
+    case TypeKind::Struct:
+    {
+        IStruct st(xcom::cast<IStruct>(type));
+        int count = st.getMemberCount();
+
+        put(count);
+        for(int i = 0; i < count; ++i)
+        {
+            putString(st.getMemberName(i).c_str());
+            putType(st.getMemberType(i));
+        }
+        break;
+    }
+    case TypeKind::Array:
+    {
+        IArray arr(xcom::cast<IArray>(type));
+        putType(arr.getElementType());
+        put(arr.getSize());
+        break;
+    }
+    case TypeKind::Sequence:
+        putType(xcom::cast<ISequence>(type).getElementType());
+        break;
+    case TypeKind::Enum:
+    {
+        IEnum en(xcom::cast<IEnum>(type));
+        int count = en.getElementCount();
+
+        put(count);
+        for(int i = 0; i < count; ++i)
+        {
+            putString(en.getElement(i).c_str());
+        }
+        break;
+    }
+    case TypeKind::Interface:
+    {
+        IInterface itf(xcom::cast<IInterface>(type));
+        xcom::GUID iid = itf.getId();
+        unsigned int guid[GUID_WORDS] = { 0 };
+
+        std::memcpy(guid, &iid, sizeof(iid));
+        for(unsigned int w = 0; w < GUID_WORDS; ++w)
+        {
+            put(guid[w]);
+        }
+
+        putType(itf.getBase());
+
+        int count = itf.getMethodCount();
+
+        put(count);
+        for(int i = 0; i < count; ++i)
+        {
+            putString(itf.getMethodName(i).c_str());
+            putParameters(itf.getParameters(i));
+        }
+        break;
+    }
+    case TypeKind::Delegate:
+        putParameters(xcom::cast<IDelegate>(type).getParameters());
+        break;
+    }
+}
+
+/**
+ * Bounds checked reading of a type record from the mapped file.
+ * Any read outside the file or string table fails the whole record.
+ */
+class Reader
+{
+public:
+    Reader(char const* data, std::size_t size,
+           unsigned int strings, unsigned int stringsSize,
+           TypeMap& visible, unsigned int offset)
+    : data_(data), size_(size), strings_(strings),
+      stringsSize_(stringsSize), visible_(visible), pos_(offset), ok_(true)
+    {
+    }
+
+    bool ok() const
+    {
+        return ok_;
+    }
+
+    unsigned int word()
+    {
+        unsigned int result = 0;
+
+        if(pos_ > size_ || size_ - pos_ < 4)
+        {
+            ok_ = false;
+        }
+        else
+        {
+            std::memcpy(&result, data_ + pos_, 4);
+            pos_ += 4;
+        }
+
+        return result;
+    }
+
+    char const* string()
+    {
+        unsigned int offset = word();
+
+        if(offset >= stringsSize_)
+        {
+            ok_ = false;
+            return "";
+        }
+
+        return data_ + strings_ + offset;
+    }
+
+    IType type()
+    {
+        return type(word());
+    }
+
+    /**
+     * Type named by the string at the given offset, nil for NONE.
+     */
+    IType type(unsigned int offset)
+    {
+        if(offset == NONE)
+        {
+            return IType();
+        }
+
+        if(offset >= stringsSize_)
+        {
+            ok_ = false;
+            return IType();
+        }
+
+        TypeMap::const_iterator i = visible_.find(data_ + strings_ + offset);
+
+        if(i == visible_.end())
+        {
+            ok_ = false;
+            return IType();
+        }
+
+        return i->second;
+    }
+
+    std::vector<ParamInfo> parameters()
+    {
+        std::vector<ParamInfo> result;
+        unsigned int count = elementCount();
+
+        for(unsigned int i = 0; i < count && ok_; ++i)
+        {
+            ParamInfo param;
+
+            param.mode = word();
+            param.type = type();
+            param.name = string();
+
+            result.push_back(param);
+        }
+
+        return result;
+    }
+
+    /**
+     * An element count, checked against the remaining file so that
+     * a damaged count does not loop for long.
+     */
+    unsigned int elementCount()
+    {
+        unsigned int count = word();
+
+        if(count > (size_ - pos_) / 4)
+        {
+            ok_ = false;
+            return 0;
+        }
+
+        return count;
+    }
+
+    xcom::GUID guid()
+    {
+        unsigned int words[GUID_WORDS];
+        xcom::GUID result;
+
+        for(unsigned int w = 0; w < GUID_WORDS; ++w)
+        {
+            words[w] = word();
+        }
+
+        std::memcpy(&result, words, sizeof(result));
+
+        return result;
+    }
+
+private:
+    char const* data_;
+    std::size_t size_;
+    unsigned int strings_;
+    unsigned int stringsSize_;
+    TypeMap& visible_;
+    std::size_t pos_;
+    bool ok_;
+};
+
+/**
+ * An interface created empty, to be filled after the other types.
+ */
+struct Shell
+{
+    Interface* itf;
+    unsigned int offset;
+};
+
+typedef std::map<std::string, Shell> ShellMap;
+
+} // namespace
+
+namespace xcomidl
+{
+
+bool ModuleFile::write(std::string const& filename,
+                       ImportCache::Module const& module)
+{
+    Writer writer;
+    Header header;
+    std::vector<Import> imports;
+
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = ORDER_MARK;
+    header.hash = module.hash;
+    header.includes = module.includes;
+    header.path = writer.intern(module.path);
+
+    std::vector<ImportCache::Module const*>::const_iterator imp =
+        module.imports.begin();
+
+    while(imp != module.imports.end())
+    {
+        Import entry;
+
+        entry.path = writer.intern((*imp)->path);
+        entry.reserved = 0;
+        entry.hash = (*imp)->hash;
+        imports.push_back(entry);
+        ++imp;
+    }
+
+    std::vector<unsigned int> noThrow;
+    std::vector<std::string>::const_iterator method = module.noThrow.begin();
+
+    while(method != module.noThrow.end())
+    {
+        noThrow.push_back(writer.intern(*method));
+        ++method;
+    }
+    
+    TypeSeq::const_iterator type = module.types.begin();
+
+    while(type != module.types.end())
+    {
+        writer.putRecord(*type);
+        ++type;
+    }
+
+    unsigned int recordsStart;
+
+    header.importCount = imports.size();
+    header.imports = sizeof(Header);
+    header.noThrowCount = noThrow.size();
+    header.noThrow = header.imports + imports.size() * sizeof(Import);
+    header.typeCount = writer.records.size();
+    header.types = header.noThrow + noThrow.size() * 4;
+    recordsStart = header.types + writer.records.size() * 4;
+    header.strings = recordsStart + writer.words.size() * 4;
+    header.stringsSize = writer.strings.size();
+
+    std::vector<unsigned int>::iterator rec = writer.records.begin();
+
+    while(rec != writer.records.end())
+    {
+        *rec = recordsStart + *rec * 4;
+        ++rec;
+    }
+
+    std::ostringstream tmpname;
+    tmpname << filename << '.' << getpid() << '.' << &module;
+
+    {
+        std::ofstream os(tmpname.str().c_str(), std::ios::binary);
+
+        if(!os)
+        {
+            return false;
+        }
+
+        os.write(reinterpret_cast<char const*>(&header), sizeof(header));
+
+        if(!imports.empty())
+        {
+            os.write(reinterpret_cast<char const*>(&imports[0]),
+                     imports.size() * sizeof(Import));
+        }
+
+        if(!noThrow.empty())
+        {
+            os.write(reinterpret_cast<char const*>(&noThrow[0]),
+                     noThrow.size() * 4);
+        }
+
+        if(!writer.records.empty())
+        {
+            os.write(reinterpret_cast<char const*>(&writer.records[0]),
+                     writer.records.size() * 4);
+            os.write(reinterpret_cast<char const*>(&writer.words[0]),
+                     writer.words.size() * 4);
+        }
+
+        os.write(writer.strings.data(), writer.strings.size());
+
+        if(!os)
+        {
+            os.close();
+            std::remove(tmpname.str().c_str());
+            return false;
+        }
+    }
+
+#ifdef _WIN32
+    std::remove(filename.c_str());
+#endif
+
+    if(std::rename(tmpname.str().c_str(), filename.c_str()) != 0)
+    {
+        std::remove(tmpname.str().c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool ModuleFile::open(std::string const& filename)
+{
+    if(!file_.open(filename.c_str()) || file_.size() < sizeof(Header))
+    {
+        return false;
+    }
+
+    std::memcpy(&header_, file_.begin(), sizeof(Header));
+
+    std::size_t size = file_.size();
+
+    // Check everything the accessors rely on once here.
+    if(std::memcmp(header_.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+       header_.version != VERSION || header_.byteOrder != ORDER_MARK ||
+       header_.strings > size || header_.stringsSize == 0 ||
+       header_.stringsSize != size - header_.strings ||
+       file_.begin()[size - 1] != '\0' ||
+       header_.path >= header_.stringsSize ||
+       header_.imports > header_.strings ||
+       header_.importCount > (header_.strings - header_.imports) /
+       sizeof(Import) ||
+       header_.noThrow > header_.strings ||
+       header_.noThrowCount > (header_.strings - header_.noThrow) / 4 ||
+       header_.types > header_.strings ||
+       header_.typeCount > (header_.strings - header_.types) / 4)
+    {
+        return false;
+    }
+
+    for(unsigned int i = 0; i < header_.importCount; ++i)
+    {
+        if(import(i).path >= header_.stringsSize)
+        {
+            return false;
+        }
+    }
+
+    for(unsigned int i = 0; i < header_.noThrowCount; ++i)
+    {
+        if(noThrowOffset(i) >= header_.stringsSize)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::string ModuleFile::getPath() const
+{
+    return string(header_.path);
+}
+
+unsigned long long ModuleFile::getHash() const
+{
+    return header_.hash;
+}
+
+unsigned long long ModuleFile::getIncludes() const
+{
+    return header_.includes;
+}
+
+int ModuleFile::getImportCount() const
+{
+    return header_.importCount;
+}
+
+std::string ModuleFile::getImportPath(int index) const
+{
+    return string(import(index).path);
+}
+
+unsigned long long ModuleFile::getImportHash(int index) const
+{
+    return import(index).hash;
+}
+
+int ModuleFile::getNoThrowCount() const
+{
+    return header_.noThrowCount;
+}
+
+std::string ModuleFile::getNoThrow(int index) const
+{
+    return string(noThrowOffset(index));
+}
+
+bool ModuleFile::readTypes(TypeMap& visible, TypeSeq& types) const
+{
+    std::vector<unsigned int> records(header_.typeCount);
+    TypeSeq created(header_.typeCount);
+    ShellMap shells;
+
+    if(header_.typeCount != 0)
+    {
+        std::memcpy(&records[0], file_.begin() + header_.types,
+                    header_.typeCount * 4);
+    }
+
+    // Interfaces may be referred before they are defined, create them
+    // empty first.
+    for(unsigned int i = 0; i < header_.typeCount; ++i)
+    {
+        Reader reader(file_.begin(), header_.strings, header_.strings,
+                      header_.stringsSize, visible, records[i]);
+
+        unsigned int kind = reader.word();
+        char const* name = reader.string();
+
+        if(!reader.ok())
+        {
+            return false;
+        }
+
+        if(kind == TypeKind::Interface)
+        {
+            Shell shell;
+
+            shell.itf = new Interface(name);
+            shell.offset = records[i];
+
+            IInterface local(shell.itf);
+
+            created[i] = local;
+            visible[name] = local;
+            shells[name] = shell;
+        }
+    }
+
+    for(unsigned int i = 0; i < header_.typeCount; ++i)
+    {
+        Reader reader(file_.begin(), header_.strings, header_.strings,
+                      header_.stringsSize, visible, records[i]);
+
+        unsigned int kind = reader.word();
+        std::string name = reader.string();
+
+        switch(kind)
+        {
+        case TypeKind::Exception:
+        case TypeKind::Struct:
+        {
+            std::unique_ptr<StructBase> type;
+
+            if(kind == TypeKind::Exception)
+            {
+                IType base = reader.type();
+
+                if(!base.isNil() && base.getKind() != TypeKind::Exception)
+                {
+                    return false;
+                }
+
+                type.reset(new Exception(name.c_str(),
+                                         xcom::cast<IException>(base), -1));
+            }
+            else
+            {
+                type.reset(new Struct(name.c_str(), -1));
+            }
+
+            unsigned int count = reader.elementCount();
+
+            for(unsigned int m = 0; m < count && reader.ok(); ++m)
+            {
+                std::string member = reader.string();
+                IType memberType = reader.type();
+
+                if(reader.ok())
+                {
+                    type->addMember(member, memberType);
+                }
+            }
+
+            if(!reader.ok())
+            {
+                return false;
+            }
+
+            created[i] = type.release();
+            break;
+        }
+        case TypeKind::Array:
+        {
+            IType element = reader.type();
+            int size = reader.word();
+
+            if(!reader.ok())
+            {
+                return false;
+            }
+
+            created[i] = new xcom::metadata::Array(name.c_str(), element,
+                                                   size);
+            break;
+        }
+        case TypeKind::Sequence:
+        {
+            IType element = reader.type();
+
+            if(!reader.ok())
+            {
+                return false;
+            }
+
+            created[i] = new xcom::metadata::Sequence(name.c_str(), element);
+            break;
+        }
+        case TypeKind::Enum:
+        {
+            std::unique_ptr<Enum> type(new Enum(name.c_str()));
+            unsigned int count = reader.elementCount();
+
+            for(unsigned int e = 0; e < count && reader.ok(); ++e)
+            {
+                char const* element = reader.string();
+
+                if(reader.ok())
+                {
+                    type->addElement(element);
+                }
+            }
+
+            if(!reader.ok())
+            {
+                return false;
+            }
+
+            created[i] = type.release();
+            break;
+        }
+        case TypeKind::Delegate:
+        {
+            std::vector<ParamInfo> params(reader.parameters());
+
+            if(!reader.ok())
+            {
+                return false;
+            }
+
+            created[i] = new xcom::metadata::Delegate(name.c_str(), params);
+            break;
+        }
+        case TypeKind::Interface:
+            continue;
+        default:
+            return false;
+        }
+
+        visible[name] = created[i];
+    }
+
+    // Fill interfaces, bases first since a derived interface continues
+    // the methods of its base.
+    while(!shells.empty())
+    {
+        std::vector<std::string> chain(1, shells.begin()->first);
+
+        while(!chain.empty())
+        {
+            ShellMap::iterator current = shells.find(chain.back());
+            Reader reader(file_.begin(), header_.strings, header_.strings,
+                          header_.stringsSize, visible,
+                          current->second.offset);
+
+            reader.word();
+            reader.string();
+
+            xcom::GUID iid = reader.guid();
+            unsigned int baseOffset = reader.word();
+
+            if(!reader.ok())
+            {
+                return false;
+            }
+
+            if(baseOffset != NONE)
+            {
+                if(baseOffset >= header_.stringsSize)
+                {
+                    return false;
+                }
+
+                std::string baseName(file_.begin() + header_.strings +
+                                     baseOffset);
+
+                if(shells.find(baseName) != shells.end())
+                {
+                    if(std::find(chain.begin(), chain.end(), baseName) !=
+                       chain.end())
+                    {
+                        return false;
+                    }
+
+                    chain.push_back(baseName);
+                    continue;
+                }
+            }
+
+            IType baseType = reader.type(baseOffset);
+            IInterface base;
+
+            if(!reader.ok() || (baseOffset != NONE &&
+                                baseType.getKind() != TypeKind::Interface))
+            {
+                return false;
+            }
+
+            if(baseOffset != NONE)
+            {
+                base = xcom::cast<IInterface>(baseType);
+            }
+
+            Interface* itf = current->second.itf;
+            unsigned int count = reader.elementCount();
+
+            itf->satisfyForward(iid, base);
+
+            for(unsigned int m = 0; m < count && reader.ok(); ++m)
+            {
+                std::string method = reader.string();
+                std::vector<ParamInfo> params(reader.parameters());
+
+                if(reader.ok())
+                {
+                    itf->addMethod(method.c_str(), params);
+                }
+            }
+
+            if(!reader.ok())
+            {
+                return false;
+            }
+
+            shells.erase(current);
+            chain.pop_back();
+        }
+    }
+
+    types.insert(types.end(), created.begin(), created.end());
+
+    return true;
+}
+
+char const* ModuleFile::string(unsigned int offset) const
+{
+    return file_.begin() + header_.strings + offset;
+}
+
+unsigned int ModuleFile::noThrowOffset(int index) const
+{
+    unsigned int result;
+
+    std::memcpy(&result, file_.begin() + header_.noThrow + index * 4, 4);
+
+    return result;
+}
+
+ModuleFile::Import ModuleFile::import(int index) const
+{
+    Import result;
+
+    std::memcpy(&result,
+                file_.begin() + header_.imports + index * sizeof(Import),
+                sizeof(Import));
+
+    return result;
+}
+
+} // namespace xcomidl
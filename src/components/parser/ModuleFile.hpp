@@ -0,0 +1,174 @@
+/**
+ * File    : ModuleFile.hpp
+ * Author  : Emir Uner
+ * Summary : Binary form of parsed idl modules kept on disk.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_MODULEFILE_HPP_INCLUDED
+#define XCOMIDL_MODULEFILE_HPP_INCLUDED
+
+#include "ImportCache.hpp"
+#include "SourceFile.hpp"
+
+#include <xcomidl/Hash.hpp>
+
+#include <string>
+#include <unordered_map>
+
+namespace xcomidl
+{
+
+/**
+ * Types visible while reading a module file, by scoped name.
+ */
+typedef std::unordered_map<std::string, xcom::metadata::IType> TypeMap;
+
+/**
+ * A parsed module stored in a file. The file is a header followed by
+ * the import table, a table of the string offsets of the nothrow
+ * methods, a table of type record offsets, the type records
+ * as 32 bit words and a string table, all addressed by offsets from
+ * the beginning, so it is read directly from the mapped file.
+ * Types refer to each other by scoped name. Built-in types are
+ * referred by their idl names.
+ */
+class ModuleFile
+{
+public:
+    /**
+     * Write the module to the file. The file is written under a
+     * temporary name and renamed, so readers never see a partial file.
+     * Returns false if the file cannot be written.
+     */
+    static bool write(std::string const& filename,
+                      ImportCache::Module const& module);
+
+    /**
+     * Map the file and check its header.
+     * Returns false if the file does not exist or is not a module file.
+     */
+    bool open(std::string const& filename);
+
+    /**
+     * Canonical path of the idl file.
+     */
+    std::string getPath() const;
+
+    /**
+     * Content hash of the idl file when it was parsed.
+     */
+    unsigned long long getHash() const;
+
+    /**
+     * Hash of the include paths the imports were found in.
+     */
+    unsigned long long getIncludes() const;
+
+    /**
+     * Number of modules imported by the file.
+     */
+    int getImportCount() const;
+
+    /**
+     * Canonical path of the imported file.
+     */
+    std::string getImportPath(int index) const;
+
+    /**
+     * Content hash of the imported file when the module was parsed.
+     */
+    unsigned long long getImportHash(int index) const;
+
+    /**
+     * Number of methods declared nothrow in the file.
+     */
+    int getNoThrowCount() const;
+
+    /**
+     * Nothrow method as the scoped interface name and the method name
+     * joined by a dot.
+     */
+    std::string getNoThrow(int index) const;
+
+    /**
+     * Create the types of the module, in definition order. Types referred
+     * are searched in visible, the created types are added to it.
+     * Returns false if the file is malformed or refers to a type that is
+     * not visible.
+     */
+    bool readTypes(TypeMap& visible, TypeSeq& types) const;
+
+private:
+    /**
+     * Fixed part at the beginning of the file.
+     */
+    struct Header
+    {
+        char magic[8];
+        unsigned int version;
+        unsigned int byteOrder;
+        unsigned long long hash;
+        unsigned long long includes;
+        unsigned int path;
+        unsigned int importCount;
+        unsigned int imports;
+        unsigned int noThrowCount;
+        unsigned int noThrow;
+        unsigned int typeCount;
+        unsigned int types;
+        unsigned int strings;
+        unsigned int stringsSize;
+    };
+
+    /**
+     * Entry of the import table.
+     */
+    struct Import
+    {
+        unsigned int path;
+        unsigned int reserved;
+        unsigned long long hash;
+    };
+
+    SourceFile file_;
+    Header header_;
+
+    /**
+     * String at the given offset of the string table.
+     */
+    char const* string(unsigned int offset) const;
+
+    /**
+     * String table offset of the nothrow method at the given index.
+     */
+    unsigned int noThrowOffset(int index) const;
+
+    /**
+     * Entry of the import table.
+     */
+    Import import(int index) const;
+};
+
+} // namespace xcomidl
+
+#endif
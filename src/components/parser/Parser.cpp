@@ -25,6 +25,7 @@
  */
 
 #include "Parser.hpp"
+#include "ModuleFile.hpp"
 
 #include <xcom/metadata/Array.hpp>
 #include <xcom/metadata/Enum.hpp>
@@ -35,7 +36,6 @@
 #include <xcom/metadata/Delegate.hpp>
 #include <xcom/GUID.hpp>
 
-#include <fstream>
 #include <stdexcept>
 #include <utility>
 #include <algorithm>
@@ -177,41 +177,6 @@ inline bool isBuiltinOrIdentifier(TokenTypeEnum type)
     return isBuiltinTypeToken(type) || TokenType::Identifier;
 }
 
-/**
- * Tries to open the given file by prepending elements of include
- * paths and returns a dynamically allocated ifstream.
- * The second element of the pair returns the complete path of the file.
- * If cannot find the file or open it return nil.
- */
-std::pair<std::istream*, std::string>
-openIdlFile(xcom::StringSeq const& paths, char const* name)
-{
-    std::pair<std::istream*, std::string> result;
-    xcom::StringSeq::const_iterator i = paths.begin(), end = paths.end();
-    
-    while(i != end)
-    {
-        const xcom::String filename(*i + "/" + name);
-        std::ifstream* ifs = new std::ifstream(filename.c_str());
-
-        if(ifs->is_open())
-        {
-            result.first = ifs;
-            result.second = std::string(filename.c_str());
-            
-            return result;
-        }
-
-        delete ifs;        
-        ++i;
-    }
-
-    result.first = 0;
-    result.second = "";
-    
-    return result;
-}
-
 /**
  * Read and return the next token.
  * The token type must belong to either one of the built-in types
@@ -266,7 +231,7 @@ MethodInfo readMethod(Repository& repo, Lexer& lexer, Parser& parser)
     
     returnInfo.mode = PassMode::Return;
     returnInfo.type = parser.typeMustBeDefined(token);
-    returnInfo.name = "<<return>>";
+    returnInfo.name = RETURN_NAME;
     
     result.params.push_back(returnInfo);
     
@@ -302,50 +267,148 @@ MethodInfo readMethod(Repository& repo, Lexer& lexer, Parser& parser)
 
 } // namespace <unnamed>
 
-Parser::Parser(xcom::StringSeq const& includePaths, Repository& repository)
-: includePaths_(includePaths), repository_(repository)
+Parser::Parser(xcom::StringSeq const& includePaths, Repository& repository,
+               ImportCache* cache)
+: includes_(includePaths), repository_(repository), cache_(cache),
+  lexers_(symbols_), inParse_(false)
 {
 }
 
+Parser::~Parser()
+{
+    while(!openModules_.empty())
+    {
+        delete openModules_.back();
+        openModules_.pop_back();
+    }
+
+    if(inParse_)
+    {
+        cache_->endParse();
+    }
+}
+
 /**
- * FIXME: multiple inclusion check will fail if a file can be found
- * in multiple search paths.
+ * Files are compared by their identity, so a file reached through
+ * different include paths or names is imported once. The identity is
+ * the canonical path when it can be found, otherwise the path the
+ * file is found in the search paths.
  *
  * FIXME: self inclusion is not checked.
  */
 bool Parser::importedBefore(std::string const& file) const
 {
-    return std::find(processedFiles_.begin(), processedFiles_.end(), file)
-        != processedFiles_.end();
+    return processedFiles_.find(file) != processedFiles_.end();
 }
     
 void Parser::handleImport()
 {
+    bool fromMainFile = inMainFile();
     Token filename(lexer_->expectToken(TokenType::StringLiteral));
     lexer_->discardToken(TokenType::Semicolon);
 
-    std::pair<std::istream*, std::string> fileinfo = openIdlFile(
-        includePaths_, filename.asString()
-        );
+    // Files in the include paths are only opened once they are known
+    // to be neither imported before nor cached.
+    SourceFile* source = 0;
+    std::string file, path;
+    FileStamp stamp = FileStamp();
+    bool identified = false;
+
+    if(resolver_.isNil())
+    {
+        IncludeResolver::File const* found = includes_.find(
+            filename.asString()
+            );
+
+        if(found == 0)
+        {
+            lexer_->raiseError("cannot find imported idl file", filename);
+        }
 
-    if(fileinfo.first == 0)
+        file = found->path;
+        path = found->identity;
+        stamp = found->stamp;
+        identified = found->identified;
+    }
+    else
     {
-        lexer_->raiseError("cannot find imported idl file", filename);
+        source = resolveImport(filename.asString(), file);
+
+        if(source == 0)
+        {
+            lexer_->raiseError("cannot find imported idl file", filename);
+        }
+
+        path = file;
     }
+
+    // An imported file is cached only if it is parsed at global scope
+    // and does not satisfy forwards of the importing files.
+    bool cacheable = cache_ != 0 && identified &&
+        namespaces_.empty() && forwards_.empty();
     
-    if(importedBefore(fileinfo.second))
+    if(importedBefore(path))
     {
-        delete fileinfo.first;
+        delete source;
+        noteImport(processedFiles_[path]);
     }
     else
     {
-        lexers_.push(fileinfo.first, fileinfo.second);
-        lexer_ = lexers_.top();
-        processedFiles_.push_back(fileinfo.second);
+        ImportCache::Module const* cached = 0;
+
+        if(cacheable)
+        {
+            cached = cache_->find(path, stamp, includes_.getPathsHash());
+
+            ModuleSet checked;
+
+            if(cached != 0 && !cachedModuleUsable(cached, checked))
+            {
+                cached = 0;
+            }
+        }
+
+        if(cached != 0)
+        {
+            delete source;
+            applyCachedModule(cached);
+            noteImport(cached);
+        }
+        else
+        {
+            ImportCache::Module* module = 0;
+
+            if(source == 0)
+            {
+                source = new SourceFile;
+
+                if(!source->open(file.c_str()))
+                {
+                    delete source;
+                    lexer_->raiseError("cannot open imported idl file",
+                                       filename);
+                }
+            }
+            
+            if(cacheable)
+            {
+                module = new ImportCache::Module;
+                module->path = path;
+                module->includes = includes_.getPathsHash();
+                module->stamp = stamp;
+                module->verified = std::time(0);
+                module->hash = contentHash(source->begin(), source->end());
+            }
+            
+            lexers_.push(source, file);
+            lexer_ = lexers_.top();
+            openModules_.push_back(module);
+            processedFiles_[path] = 0;
+        }
 
         // Add a code generation hint in case of import
         // occured in main idl file.
-        if(lexers_.size() == 2)
+        if(fromMainFile)
         {
             addHint(CodeGenHint::GenImport, filename.asString());
         }
@@ -390,7 +453,7 @@ void Parser::handleArray()
     checkDataMember(elt, lexer_, elementType);
     checkDuplicateDefinition(name);
 
-    repository_.addType(
+    addType(
         new xcom::metadata::Array(
             scopedName(namespaces_, name.asString()).c_str(),
             elt,
@@ -420,7 +483,7 @@ void Parser::handleSequence()
 
     lexer_->discardToken(TokenType::Semicolon);       // consume ';'
     
-    repository_.addType(
+    addType(
         new xcom::metadata::Sequence(
             scopedName(namespaces_, name).c_str(),
             elementType)
@@ -486,7 +549,7 @@ void Parser::handleException()
         );
 
     readStructMembers(type.get());
-    repository_.addType(type.release());
+    addType(type.release());
 
     if(inMainFile())
     {
@@ -495,7 +558,7 @@ void Parser::handleException()
 
 }
 
-std::vector<MethodInfo> Parser::readInterfaceMembers()
+std::vector<MethodInfo> Parser::readInterfaceMembers(std::string const& name)
 {
     Token token(Token::invalidToken());
     std::vector<MethodInfo> result;
@@ -503,8 +566,27 @@ std::vector<MethodInfo> Parser::readInterfaceMembers()
     lexer_->discardToken(TokenType::LCurly);
     while((token = lexer_->expectAnyToken()).getType() != TokenType::RCurly)
     {
-        lexer_->ungetToken();
+        bool noThrow = token.getType() == TokenType::NoThrow;
+
+        if(!noThrow)
+        {
+            lexer_->ungetToken();
+        }
+        
         result.push_back(readMethod(repository_, *lexer_, *this));
+
+        if(noThrow)
+        {
+            std::string method(name + "." + result.back().name.c_str());
+            ImportCache::Module* module = openModules_.back();
+
+            addHint(CodeGenHint::NoThrow, method);
+
+            if(module != 0)
+            {
+                module->noThrow.push_back(method);
+            }
+        }
     }
 
     return result;
@@ -573,7 +655,7 @@ void Parser::handleInterface()
             IInterface local(itf);
             
             forwards_.push_back(itf);
-            repository_.addType(local);
+            addType(local);
         }
         
         if(inMainFile())
@@ -591,7 +673,7 @@ void Parser::handleInterface()
             IInterface local(itf);
             
             oldDef = local;
-            repository_.addType(local);
+            addType(local);
             forwards_.push_back(itf);
         }
         
@@ -643,7 +725,7 @@ void Parser::handleInterface()
         itf->satisfyForward(iid, base);
         removeForward(forwards_, itf);
         
-        std::vector<MethodInfo> methods(readInterfaceMembers());
+        std::vector<MethodInfo> methods(readInterfaceMembers(name));
         
         for(std::vector<MethodInfo>::iterator it = methods.begin();
             it != methods.end(); ++it)
@@ -666,7 +748,7 @@ void Parser::handleDelegate()
     xcom::metadata::Delegate* del = new xcom::metadata::Delegate(
         name.c_str(), signature.params);
     
-    repository_.addType(del);
+    addType(del);
 
     if(inMainFile())
     {
@@ -709,7 +791,7 @@ void Parser::handleEnum()
         lexer_->raiseError("an enumeration with no element", enumStart);
     }
                            
-    repository_.addType(type.release());
+    addType(type.release());
 
     if(inMainFile())
     {
@@ -733,7 +815,7 @@ void Parser::handleStruct()
         lexer_->raiseError("structs with no elements are not allowed", token);
     }
     
-    repository_.addType(type.release());
+    addType(type.release());
 
     if(inMainFile())
     {
@@ -742,14 +824,58 @@ void Parser::handleStruct()
 }
 
 HintSeq const& Parser::parse(std::string const& idlFile)
+{
+    reset();
+    enterIdlFile(idlFile.c_str());
+
+    return parseFiles();
+}
+
+HintSeq const& Parser::parseBuffer(std::string const& name,
+                                   std::string const& contents)
+{
+    reset();
+    enterIdlBuffer(contents.data(), contents.data() + contents.size(),
+                   name.c_str());
+
+    return parseFiles();
+}
+
+void Parser::setImportResolver(IImportResolver const& resolver)
+{
+    resolver_ = resolver;
+}
+
+void Parser::reset()
 {
     // Clear per parse specific data.
     hints_.clear();
     namespaces_.clear();
     lexers_.clear();
     processedFiles_.clear();
-    
-    enterIdlFile(idlFile.c_str());
+    owners_.clear();
+    imported_.clear();
+
+    if(cache_ != 0)
+    {
+        if(inParse_)
+        {
+            cache_->endParse();
+        }
+
+        cache_->beginParse();
+        inParse_ = true;
+    }
+
+    while(!openModules_.empty())
+    {
+        delete openModules_.back();
+        openModules_.pop_back();
+    }
+}
+
+HintSeq const& Parser::parseFiles()
+{
     while(lexers_.size() != 0)
     {
         Token token(lexer_->getNextToken());
@@ -757,15 +883,7 @@ HintSeq const& Parser::parse(std::string const& idlFile)
         switch(token.getType())
         {
         case TokenType::Eof:
-            lexers_.pop();
-            if(lexers_.size() == 0)
-            {
-                lexer_ = 0;
-            }
-            else
-            {
-                lexer_ = lexers_.top();
-            }
+            leaveIdlFile();
             break;
             
         case TokenType::Import:
@@ -824,18 +942,280 @@ HintSeq const& Parser::parse(std::string const& idlFile)
     return hints_;
 }
     
+StringVec Parser::getDependencies() const
+{
+    StringVec result;
+    ProcessedMap::const_iterator i = processedFiles_.begin();
+
+    while(i != processedFiles_.end())
+    {
+        result.push_back(i->first);
+        ++i;
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+    
 void Parser::enterIdlFile(char const* filename)
 {
-    std::ifstream* in = new std::ifstream(filename);
-    if(!in->is_open())
+    SourceFile* source = new SourceFile;
+    if(!source->open(filename))
     {
-        delete in;
+        delete source;
         throw std::runtime_error(std::string("cannot open idl file: ")
                                  + filename);
     }
     
-    lexers_.push(in, filename);
+    lexers_.push(source, filename);
+    lexer_ = lexers_.top();
+    openModules_.push_back(0);
+}
+
+void Parser::enterIdlBuffer(char const* begin, char const* end,
+                            char const* name)
+{
+    lexers_.push(begin, end, name);
     lexer_ = lexers_.top();
+    openModules_.push_back(0);
+}
+
+SourceFile* Parser::resolveImport(std::string const& name, std::string& path)
+{
+    xcom::String resolved, contents;
+
+    if(!resolver_.resolve(name.c_str(), resolved, contents))
+    {
+        return 0;
+    }
+
+    SourceFile* source = new SourceFile;
+
+    source->assign(contents.data(), contents.size());
+    path = resolved.c_str();
+
+    return source;
+}
+
+void Parser::leaveIdlFile()
+{
+    lexers_.pop();
+    
+    if(lexers_.size() == 0)
+    {
+        lexer_ = 0;
+    }
+    else
+    {
+        lexer_ = lexers_.top();
+    }
+
+    // A file leaving forwards unsatisfied cannot be reused alone.
+    if(openModules_.back() != 0 && forwards_.size() != 0)
+    {
+        dropOpenModule();
+    }
+    
+    ImportCache::Module* module = openModules_.back();
+    openModules_.pop_back();
+    
+    if(module == 0)
+    {
+        noteImport(0);
+    }
+    else
+    {
+        processedFiles_[module->path] = cache_->insert(module);
+        noteImport(module);
+    }
+}
+
+void Parser::addType(IType const& type)
+{
+    repository_.addType(type);
+    
+    ImportCache::Module* module = openModules_.back();
+    
+    if(module != 0)
+    {
+        module->types.push_back(type);
+        owners_[typeName(type)] = module;
+    }
+}
+
+void Parser::noteReference(IType const& type)
+{
+    if(openModules_.back() == 0 || isBuiltin(type.getKind()))
+    {
+        return;
+    }
+    
+    OwnerMap::const_iterator owner = owners_.find(typeName(type));
+
+    if(owner == owners_.end())
+    {
+        noteImport(0);
+    }
+    else if(owner->second != openModules_.back() &&
+            !importsModule(owner->second))
+    {
+        // The type is visible only because of what is parsed before,
+        // the file would not parse the same on its own.
+        noteImport(0);
+    }
+}
+
+void Parser::noteImport(ImportCache::Module const* module)
+{
+    if(openModules_.empty() || openModules_.back() == 0)
+    {
+        return;
+    }
+
+    if(module == 0)
+    {
+        dropOpenModule();
+        return;
+    }
+    
+    std::vector<ImportCache::Module const*>& imports =
+        openModules_.back()->imports;
+
+    if(std::find(imports.begin(), imports.end(), module) == imports.end())
+    {
+        imports.push_back(module);
+    }
+}
+
+void Parser::dropOpenModule()
+{
+    ImportCache::Module* module = openModules_.back();
+    TypeSeq::const_iterator i = module->types.begin();
+
+    while(i != module->types.end())
+    {
+        owners_.erase(typeName(*i));
+        ++i;
+    }
+
+    delete module;
+    openModules_.back() = 0;
+}
+
+bool Parser::importsModule(ImportCache::Module const* module)
+{
+    std::vector<ImportCache::Module const*> const& imports =
+        openModules_.back()->imports;
+    std::vector<ImportCache::Module const*>::const_iterator i;
+
+    for(i = imports.begin(); i != imports.end(); ++i)
+    {
+        if(*i == module || importedBy(*i).count(module) != 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Parser::ModuleSet const&
+Parser::importedBy(ImportCache::Module const* module)
+{
+    ImportClosureMap::const_iterator found = imported_.find(module);
+
+    if(found != imported_.end())
+    {
+        return found->second;
+    }
+
+    ModuleSet result;
+    std::vector<ImportCache::Module const*>::const_iterator i;
+
+    for(i = module->imports.begin(); i != module->imports.end(); ++i)
+    {
+        ModuleSet const& indirect = importedBy(*i);
+        
+        result.insert(*i);
+        result.insert(indirect.begin(), indirect.end());
+    }
+
+    ModuleSet& slot = imported_[module];
+    
+    slot.swap(result);
+    return slot;
+}
+
+bool Parser::cachedModuleUsable(ImportCache::Module const* module,
+                                ModuleSet& checked) const
+{
+    if(!checked.insert(module).second)
+    {
+        return true;
+    }
+    
+    std::vector<ImportCache::Module const*>::const_iterator dep;
+
+    for(dep = module->imports.begin(); dep != module->imports.end(); ++dep)
+    {
+        ProcessedMap::const_iterator processed =
+            processedFiles_.find((*dep)->path);
+
+        if(processed != processedFiles_.end())
+        {
+            if(processed->second != *dep)
+            {
+                return false;
+            }
+        }
+        else if(!cachedModuleUsable(*dep, checked))
+        {
+            return false;
+        }
+    }
+
+    TypeSeq::const_iterator i;
+
+    for(i = module->types.begin(); i != module->types.end(); ++i)
+    {
+        if(!repository_.findType(typeName(*i)).isNil())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Parser::applyCachedModule(ImportCache::Module const* module)
+{
+    std::vector<ImportCache::Module const*>::const_iterator dep;
+
+    for(dep = module->imports.begin(); dep != module->imports.end(); ++dep)
+    {
+        if(!importedBefore((*dep)->path))
+        {
+            applyCachedModule(*dep);
+        }
+    }
+
+    TypeSeq::const_iterator i;
+
+    for(i = module->types.begin(); i != module->types.end(); ++i)
+    {
+        repository_.addType(*i);
+        owners_[typeName(*i)] = module;
+    }
+
+    std::vector<std::string>::const_iterator method;
+
+    for(method = module->noThrow.begin(); method != module->noThrow.end();
+        ++method)
+    {
+        addHint(CodeGenHint::NoThrow, *method);
+    }
+    
+    processedFiles_[module->path] = module;
 }
 
 void Parser::addHint(CodeGenHintEnum type, std::string parameter)
@@ -890,6 +1270,7 @@ IType Parser::typeMustBeDefined(Token& token)
         lexer_->raiseError("type not found", token);
     }
 
+    noteReference(result);
     return result;
 }
 
@@ -39,6 +39,12 @@
 #include <xcomidl/ParserTypes.hpp>
 
 #include "LexerStack.hpp"
+#include "ImportCache.hpp"
+#include "IncludeResolver.hpp"
+
+#include <map>
+#include <set>
+#include <unordered_map>
 
 namespace xcomidl
 {
@@ -59,8 +65,15 @@ public:
     /**
      * Parser with given include paths.
      * Writes type information into the given repository object.
+     * Imported files are taken from and added to the cache if it is not nil.
+     */
+    Parser(xcom::StringSeq const& includePaths, Repository& repository,
+           ImportCache* cache);
+
+    /**
+     * Cleanup.
      */
-    Parser(xcom::StringSeq const& includePaths, Repository& repository);
+    ~Parser();
     
     /**
      * Parse given idl file.
@@ -69,6 +82,25 @@ public:
      * The returned hint vector is only specific to the given idl file.
      */
     HintSeq const& parse(std::string const& idlFile);
+
+    /**
+     * Parse the idl in contents like parse, name is used for the main
+     * file in messages.
+     */
+    HintSeq const& parseBuffer(std::string const& name,
+                               std::string const& contents);
+
+    /**
+     * Find imported files through the given resolver instead of the
+     * include paths. A nil resolver restores the include paths.
+     */
+    void setImportResolver(IImportResolver const& resolver);
+
+    /**
+     * Paths of the files imported by the last parsed idl file
+     * directly or indirectly.
+     */
+    StringVec getDependencies() const;
     
     /**
      * Assumes that the identifier in the token is in ::xx::yy::zz format.
@@ -92,12 +124,93 @@ private:
      */
     void addHint(CodeGenHintEnum type, std::string parameter);
     
+    /**
+     * Clear the state of the previous parse.
+     */
+    void reset();
+    
+    /**
+     * Parse the files until the main idl file is finished.
+     */
+    HintSeq const& parseFiles();
+    
     /**
      * Tries to open the given file, throws exception in failure,
      * and create a lexer associated with that file.
      */
     void enterIdlFile(char const* filename);
 
+    /**
+     * Create a lexer for the main idl file with the contents in
+     * [begin, end), which must outlive the parse.
+     */
+    void enterIdlBuffer(char const* begin, char const* end, char const* name);
+
+    /**
+     * Find the imported file through the resolver and return its
+     * contents, nil if it is not found. The path is set to the path
+     * the resolver gives for the file.
+     */
+    SourceFile* resolveImport(std::string const& name, std::string& path);
+
+    /**
+     * Finish the current idl file. If it is an import that can be
+     * cached its module is added to the cache.
+     */
+    void leaveIdlFile();
+
+    /**
+     * Add a type defined in the current idl file to the repository.
+     */
+    void addType(xcom::metadata::IType const& type);
+
+    /**
+     * Record that the current idl file refers to the given type.
+     */
+    void noteReference(xcom::metadata::IType const& type);
+
+    /**
+     * Record that the current idl file imports the given module.
+     * A nil module means a file that is not cached and makes the
+     * current file uncacheable.
+     */
+    void noteImport(ImportCache::Module const* module);
+
+    /**
+     * Stop collecting the module of the current idl file.
+     */
+    void dropOpenModule();
+
+    typedef std::set<ImportCache::Module const*> ModuleSet;
+    typedef std::map<ImportCache::Module const*, ModuleSet> ImportClosureMap;
+    
+    /**
+     * Return true if the current idl file imports the given module
+     * directly or indirectly.
+     */
+    bool importsModule(ImportCache::Module const* module);
+
+    /**
+     * Modules the finished module imports directly or indirectly.
+     * Computed once per module and parse.
+     */
+    ModuleSet const& importedBy(ImportCache::Module const* module);
+    
+    /**
+     * Return true if the cached module and the modules it imports
+     * can be added without clashing with what is parsed so far.
+     * Modules in checked are known to be usable and are skipped,
+     * each module examined is added to it.
+     */
+    bool cachedModuleUsable(ImportCache::Module const* module,
+                            ModuleSet& checked) const;
+
+    /**
+     * Add the types of a cached module and of the modules it imports
+     * that are not processed yet.
+     */
+    void applyCachedModule(ImportCache::Module const* module);
+
     /**
      * Handle enum statement whose "enum" keyword is already read.
      */
@@ -145,9 +258,12 @@ private:
     void handleStruct();
     
     /**
-     * Read methods of the interface.
+     * Read methods of the interface with the given scoped name.
+     * A NoThrow hint is added for each method declared nothrow, in
+     * imported files too since derived interfaces need them.
      */
-    std::vector<xcom::metadata::MethodInfo> readInterfaceMembers();
+    std::vector<xcom::metadata::MethodInfo>
+    readInterfaceMembers(std::string const& name);
     
     /**
      * Handle interface declaration.
@@ -171,17 +287,32 @@ private:
      */
     void checkDuplicateDefinition(Token& token);
 
+    typedef std::unordered_map<std::string, ImportCache::Module const*>
+        ProcessedMap;
+    typedef std::unordered_map<std::string, ImportCache::Module const*>
+        OwnerMap;
+    
     // Parsed file independent
-    xcom::StringSeq includePaths_;
+    IncludeResolver includes_;
     Repository& repository_;
+    ImportCache* cache_;
+    IImportResolver resolver_;
+    SymbolTable symbols_; // token text, shared by all lexers
      
     // Ongoing parse operation dependent.
     StringVec namespaces_;
     HintSeq hints_;
     LexerStack lexers_;
     Lexer* lexer_; // current lexer
-    StringVec processedFiles_;
+    ProcessedMap processedFiles_; // imported files and their cached modules
     InterfaceVec forwards_; // Forward defined 
+
+    // Modules being collected for the cache, parallel to lexers_.
+    // Nil for files that cannot be cached.
+    std::vector<ImportCache::Module*> openModules_;
+    OwnerMap owners_; // type name to the module defining it
+    ImportClosureMap imported_; // imports of the finished modules
+    bool inParse_; // a parse is begun in the cache and not ended
 };
 
 } // namespace xcomidl
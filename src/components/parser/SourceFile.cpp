@@ -0,0 +1,166 @@
+/**
+ * File    : SourceFile.cpp
+ * Author  : Emir Uner
+ * Summary : Implementation file for SourceFile.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SourceFile.hpp"
+
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+namespace xcomidl
+{
+
+namespace
+{
+
+#ifndef _WIN32
+/**
+ * Read the whole file with as few read calls as its size allows.
+ * The contents are copied rather than mapped: a mapped file that is
+ * truncated while it is lexed, as --watch and --server make likely,
+ * raises SIGBUS instead of a read error.
+ */
+bool readFile(int fd, std::string& buffer)
+{
+    struct stat st;
+    
+    if(fstat(fd, &st) != 0)
+    {
+        return false;
+    }
+
+    std::size_t size = S_ISREG(st.st_mode) ? (std::size_t)st.st_size : 0;
+    std::size_t used = 0;
+    
+    // One spare byte lets the final read see the end of the file
+    // without growing the buffer.
+    buffer.resize(size + 1);
+
+    for(;;)
+    {
+        if(used == buffer.size())
+        {
+            buffer.resize(buffer.size() * 2);
+        }
+        
+        ssize_t count = read(fd, &buffer[used], buffer.size() - used);
+        
+        if(count < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            
+            return false;
+        }
+
+        if(count == 0)
+        {
+            break;
+        }
+
+        used += (std::size_t)count;
+    }
+
+    buffer.resize(used);
+    
+    return true;
+}
+#endif
+
+} // namespace <unnamed>
+
+SourceFile::SourceFile()
+: data_(""), size_(0)
+{
+}
+
+SourceFile::~SourceFile()
+{
+    close();
+}
+
+void SourceFile::close()
+{
+    data_ = "";
+    size_ = 0;
+    buffer_.clear();
+}
+
+bool SourceFile::open(char const* filename)
+{
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(filename, O_RDONLY);
+    if(fd < 0)
+    {
+        return false;
+    }
+    
+    bool success = readFile(fd, buffer_);
+    ::close(fd);
+
+    if(!success)
+    {
+        buffer_.clear();
+        return false;
+    }
+#else
+    std::ifstream in(filename, std::ios::in | std::ios::binary);
+    if(!in.is_open())
+    {
+        return false;
+    }
+
+    buffer_.assign(std::istreambuf_iterator<char>(in),
+                   std::istreambuf_iterator<char>());
+#endif
+
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    
+    return true;
+}
+
+void SourceFile::assign(char const* data, std::size_t size)
+{
+    close();
+
+    buffer_.assign(data, size);
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+ 
+} // namespace xcomidl
@@ -0,0 +1,111 @@
+/**
+ * File    : SourceFile.hpp
+ * Author  : Emir Uner
+ * Summary : Whole file contents kept in memory for lexing.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_SOURCEFILE_HPP_INCLUDED
+#define XCOMIDL_SOURCEFILE_HPP_INCLUDED
+
+#include <string>
+#include <cstddef>
+
+namespace xcomidl
+{
+
+/**
+ * Contents of a source file as a contiguous block of memory.
+ * The file is read once into an owned buffer, the lexer then scans
+ * the buffer without going through a stream.
+ */
+class SourceFile
+{
+public:
+    /**
+     * An empty source, call open to load a file.
+     */
+    SourceFile();
+
+    /**
+     * Frees the contents.
+     */
+    ~SourceFile();
+
+    /**
+     * Load the given file. Returns false if the file cannot be opened.
+     */
+    bool open(char const* filename);
+
+    /**
+     * Use a copy of the given characters as the contents.
+     */
+    void assign(char const* data, std::size_t size);
+
+    /**
+     * First character of the contents.
+     */
+    inline char const* begin() const
+    {
+        return data_;
+    }
+
+    /**
+     * One past the last character of the contents.
+     */
+    inline char const* end() const
+    {
+        return data_ + size_;
+    }
+
+    /**
+     * Number of characters.
+     */
+    inline std::size_t size() const
+    {
+        return size_;
+    }
+    
+private:
+    char const* data_;
+    std::size_t size_;
+    std::string buffer_;
+
+    /**
+     * Release current contents.
+     */
+    void close();
+    
+    /**
+     * Copy constructor.
+     */
+    SourceFile(SourceFile const&);
+
+    /**
+     * Assignment op.
+     */
+    SourceFile& operator=(SourceFile const&);
+};
+ 
+} // namespace xcomidl
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * File    : SymbolTable.cpp
+ * Author  : Emir Uner
+ * Summary : SymbolTable implementation.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SymbolTable.hpp"
+
+#include <xcomidl/Hash.hpp>
+
+#include <string.h>
+
+namespace
+{
+    /**
+     * Size of the blocks the characters of symbols are stored in.
+     */
+    const std::size_t chunkSize = 64 * 1024;
+}
+
+namespace xcomidl
+{
+
+std::size_t SymbolTable::KeyHash::operator()(Key const& key) const
+{
+    return static_cast<std::size_t>(
+        contentHash(key.str, key.str + key.length));
+}
+
+bool SymbolTable::KeyEqual::operator()(Key const& lhs, Key const& rhs) const
+{
+    return lhs.length == rhs.length &&
+        memcmp(lhs.str, rhs.str, lhs.length) == 0;
+}
+    
+SymbolTable::SymbolTable()
+: free_(0), freeSize_(0)
+{
+}
+
+SymbolTable::~SymbolTable()
+{
+    std::vector<char*>::iterator it = chunks_.begin(), end = chunks_.end();
+    
+    while(it != end)
+    {
+        delete[] *it;
+        ++it;
+    }
+}
+
+Symbol const* SymbolTable::intern(char const* str, std::size_t length)
+{
+    Key key;
+
+    key.str = str;
+    key.length = length;
+    
+    Index::const_iterator found = index_.find(key);
+    if(found != index_.end())
+    {
+        return found->second;
+    }
+
+    Symbol symbol;
+    
+    symbol.str = store(str, length);
+    symbol.length = (int)length;
+    symbol.id = (int)symbols_.size();
+    symbols_.push_back(symbol);
+
+    key.str = symbol.str;
+    index_.insert(Index::value_type(key, &symbols_.back()));
+    
+    return &symbols_.back();
+}
+
+int SymbolTable::size() const
+{
+    return (int)symbols_.size();
+}
+
+char const* SymbolTable::store(char const* str, std::size_t length)
+{
+    char* result;
+    
+    if(length + 1 > freeSize_)
+    {
+        if(length + 1 > chunkSize / 4)
+        {
+            // Large strings get a block of their own.
+            result = new char[length + 1];
+            chunks_.push_back(result);
+            memcpy(result, str, length);
+            result[length] = '\0';
+            return result;
+        }
+        
+        free_ = new char[chunkSize];
+        freeSize_ = chunkSize;
+        chunks_.push_back(free_);
+    }
+
+    result = free_;
+    memcpy(result, str, length);
+    result[length] = '\0';
+    free_ += length + 1;
+    freeSize_ -= length + 1;
+    
+    return result;
+}
+ 
+} // namespace xcomidl
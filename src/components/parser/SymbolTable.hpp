@@ -0,0 +1,124 @@
+/**
+ * File    : SymbolTable.hpp
+ * Author  : Emir Uner
+ * Summary : Interned strings for token values.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_SYMBOLTABLE_HPP_INCLUDED
+#define XCOMIDL_SYMBOLTABLE_HPP_INCLUDED
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+
+namespace xcomidl
+{
+
+/**
+ * An interned string. The characters are null terminated and
+ * stay valid as long as the owning SymbolTable exists.
+ * Two symbols of the same table are equal iff their ids are equal.
+ */
+struct Symbol
+{
+    char const* str;
+    int length;
+    int id;
+};
+    
+/**
+ * Stores each distinct string once and hands out Symbol's for them.
+ * Looking up an already interned string does not allocate.
+ */
+class SymbolTable
+{
+public:
+    /**
+     * An empty table.
+     */
+    SymbolTable();
+
+    /**
+     * Frees the stored strings.
+     */
+    ~SymbolTable();
+    
+    /**
+     * Return the symbol for the given characters, adding it
+     * if it is not present.
+     */
+    Symbol const* intern(char const* str, std::size_t length);
+
+    /**
+     * Number of distinct symbols.
+     */
+    int size() const;
+    
+private:
+    /**
+     * A span of characters used as the lookup key.
+     */
+    struct Key
+    {
+        char const* str;
+        std::size_t length;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(Key const& key) const;
+    };
+
+    struct KeyEqual
+    {
+        bool operator()(Key const& lhs, Key const& rhs) const;
+    };
+
+    typedef std::unordered_map<Key, Symbol const*, KeyHash, KeyEqual> Index;
+    
+    Index index_;
+    std::deque<Symbol> symbols_;
+    std::vector<char*> chunks_;
+    char* free_;
+    std::size_t freeSize_;
+
+    /**
+     * Copy the characters into table owned storage.
+     */
+    char const* store(char const* str, std::size_t length);
+    
+    /**
+     * Copy constructor.
+     */
+    SymbolTable(SymbolTable const&);
+
+    /**
+     * Assignment op.
+     */
+    SymbolTable& operator=(SymbolTable const&);
+};
+ 
+} // namespace xcomidl
+
+#endif
@@ -26,10 +26,6 @@
 
 #include "Token.hpp"
 
-#include <stdio.h>
-#include <string.h>
-#include <stdlib.h>
-
 #include <cassert>
 
 namespace
@@ -46,46 +42,21 @@ namespace xcomidl
 {
             
 Token::Token(TokenTypeEnum type, int lineNo)
-: type_(type), lineNo_(lineNo)
+: type_(type), symbol_(0), intVal_(0), lineNo_(lineNo)
 {
     assert(!stringToken(type));
 }
     
-Token::Token(TokenTypeEnum type, int lineNo, char const* value)
-: type_(type), lineNo_(lineNo)
+Token::Token(TokenTypeEnum type, int lineNo, Symbol const* value)
+: type_(type), symbol_(value), intVal_(0), lineNo_(lineNo)
 {
     assert(stringToken(type));
-    strVal_ = value;
 }
 
-Token::Token(TokenTypeEnum type, int lineNo, int value)
-: type_(type), lineNo_(lineNo)
+Token::Token(TokenTypeEnum type, int lineNo, int value, Symbol const* text)
+: type_(type), symbol_(text), intVal_(value), lineNo_(lineNo)
 {
     assert(type == TokenType::PositiveInt);
-    intVal_ = value;
-    char buf[20];
-    sprintf(buf, "%d", value);
-    strVal_ = buf;
-}
-
-Token::Token(Token const& other)
-: type_(other.type_), lineNo_(other.lineNo_)
-{
-    intVal_ = other.intVal_;
-    strVal_ = other.strVal_;
-}
-
-Token& Token::operator=(Token const& rhs)
-{
-    if(this != &rhs)
-    {
-        type_ = rhs.type_;
-        lineNo_ = rhs.lineNo_;        
-        intVal_ = rhs.intVal_;
-        strVal_ = rhs.strVal_;
-    }
-    
-    return *this;
 }
 
 int Token::asInteger() const
@@ -94,11 +65,16 @@ int Token::asInteger() const
     return intVal_;
 }
 
+Symbol const* Token::getSymbol() const
+{
+    return symbol_;
+}
+
 char const* Token::asString() const
 {
     switch(type_)
     {
-    case TokenType::Invalid: return strVal_.c_str();
+    case TokenType::Invalid: return symbol_->str;
     case TokenType::Comma: return ",";
     case TokenType::Semicolon: return ";";
     case TokenType::LParen: return "(";
@@ -107,8 +83,8 @@ char const* Token::asString() const
     case TokenType::RCurly: return "}";
     case TokenType::LessThan: return "<";
     case TokenType::GreaterThan: return ">";
-    case TokenType::StringLiteral: return strVal_.c_str();
-    case TokenType::Identifier: return strVal_.c_str();
+    case TokenType::StringLiteral: return symbol_->str;
+    case TokenType::Identifier: return symbol_->str;
     case TokenType::Void: return "void";
     case TokenType::Namespace: return "namespace";
     case TokenType::Interface: return "interface";
@@ -134,7 +110,7 @@ char const* Token::asString() const
     case TokenType::Enum: return "enum";
     case TokenType::Import: return "import";
     case TokenType::NoThrow: return "nothrow";
-    case TokenType::PositiveInt: return strVal_.c_str();
+    case TokenType::PositiveInt: return symbol_->str;
     case TokenType::Any: return "any";
     case TokenType::Delegate: return "delegate";
     default:
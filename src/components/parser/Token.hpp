@@ -27,7 +27,7 @@
 #ifndef XCOMIDL_TOKEN_HPP_INCLUDED
 #define XCOMIDL_TOKEN_HPP_INCLUDED
 
-#include <string>
+#include "SymbolTable.hpp"
 
 namespace xcomidl
 {
@@ -81,6 +81,11 @@ namespace TokenType
 
 typedef TokenType::type TokenTypeEnum;
 
+/**
+ * A token read by the Lexer. Tokens carrying text refer to an
+ * interned Symbol instead of owning a string, so they are cheap to copy.
+ * The text stays valid while the SymbolTable the lexer uses exists.
+ */
 class Token
 {
 public:
@@ -102,27 +107,23 @@ public:
     /**
      * Used for tokens containing a string value and a type.
      */
-    Token(TokenTypeEnum type, int lineNo, char const* value);
+    Token(TokenTypeEnum type, int lineNo, Symbol const* value);
 
     /**
-     * Used for PositiveInt token.
+     * Used for PositiveInt token, text is the string form of the value.
      */
-    Token(TokenTypeEnum type, int lineNo, int value);
+    Token(TokenTypeEnum type, int lineNo, int value, Symbol const* text);
 
     /**
-     * Copy.
-     */
-    Token(Token const& other);
-    
-    /**
-     * Assignment op.
+     * Get string value of the token.
      */
-    Token& operator=(Token const& rhs);
+    char const* asString() const;
     
     /**
-     * Get string value of the token.
+     * Get the interned value of a string or PositiveInt token.
+     * Returns nil for other tokens.
      */
-    char const* asString() const;
+    Symbol const* getSymbol() const;
     
     /**
      * Get integer value of the token.
@@ -142,7 +143,7 @@ public:
     
 private:
     TokenTypeEnum type_;
-    std::string strVal_;
+    Symbol const* symbol_;
     int intVal_;
     int lineNo_;
 };
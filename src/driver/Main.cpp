@@ -28,12 +28,23 @@
 #include <fstream>
 #include <algorithm>
 #include <iterator>
+#include <map>
 #include <set>
 #include <stdexcept>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdlib>
+#include <ctime>
 
 #include <xcom/Loader.hpp>
 #include <xcomidl/ParserTypes.hpp>
 
+#include "Server.hpp"
+#include "Watch.hpp"
+#include "OutputFile.hpp"
+
 using namespace std;
 
 bool includePathAhead(xcom::String const& arg)
@@ -90,6 +101,225 @@ xcom::StringSeq filterIncludePaths(xcom::StringSeq& args)
     return result;
 }
 
+/**
+ * Removes -j option from the arguments and returns the number of files
+ * to compile at the same time. Returns 1 if the option is not present.
+ */
+int filterJobCount(xcom::StringSeq& args)
+{
+    int result = 1;
+    xcom::StringSeq::iterator i;
+
+    i = args.begin();
+    while(i != args.end())
+    {
+        if(i->compare(0, 2, "-j") == 0)
+        {
+            xcom::String count;
+            
+            if(i->size() == 2)
+            {
+                i = args.erase(i);
+
+                if(i == args.end())
+                {
+                    throw runtime_error("an argument must follow a '-j'");
+                }
+
+                count = *i;
+            }
+            else
+            {
+                count = xcom::String(i->begin() + 2, i->end());
+            }
+            
+            i = args.erase(i);
+            result = atoi(count.c_str());
+            
+            if(result <= 0)
+            {
+                throw runtime_error("'-j' needs a positive job count");
+            }
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Removes the given option and the argument following it from the
+ * arguments and returns the argument. Returns an empty string if the
+ * option is not present.
+ */
+xcom::String filterValueOption(xcom::StringSeq& args, xcom::String const& name)
+{
+    xcom::String result;
+    xcom::StringSeq::iterator i;
+
+    i = args.begin();
+    while(i != args.end())
+    {
+        if(*i == name)
+        {
+            i = args.erase(i);
+
+            if(i == args.end())
+            {
+                throw runtime_error("an argument must follow a '" + name + "'");
+            }
+
+            result = *i;
+            i = args.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Dependency file settings. If enabled a make rule listing the idl
+ * files the generated headers depend on is written for each input,
+ * into file if it is given otherwise into a .d file named after the idl.
+ */
+struct DependencyOptions
+{
+    bool enabled;
+    xcom::String file;
+};
+    
+/**
+ * Removes -MD and -MF options from the arguments.
+ */
+DependencyOptions filterDependencyOptions(xcom::StringSeq& args)
+{
+    DependencyOptions result;
+    xcom::StringSeq::iterator i;
+
+    result.enabled = false;
+    
+    i = args.begin();
+    while(i != args.end())
+    {
+        if(*i == "-MD")
+        {
+            result.enabled = true;
+            i = args.erase(i);
+        }
+        else if(*i == "-MF")
+        {
+            i = args.erase(i);
+
+            if(i == args.end())
+            {
+                throw runtime_error("an argument must follow a '-MF'");
+            }
+
+            result.enabled = true;
+            result.file = *i;
+            i = args.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * File name without the directory and extension.
+ */
+xcom::String baseName(xcom::String const& path)
+{
+    xcom::String::size_type begin = path.rfind('/');
+
+    begin = (begin == xcom::String::npos) ? 0 : begin + 1;
+
+    return xcom::String(path.begin() + begin,
+                        path.begin() + min(path.find('.', begin), path.size()));
+}
+
+/**
+ * The path resolved against the directory. Absolute paths and all
+ * paths for an empty directory are returned as they are.
+ */
+xcom::String resolvePath(xcom::String const& directory,
+                         xcom::String const& path)
+{
+    if(directory.size() == 0 || (path.size() != 0 && path[0] == '/'))
+    {
+        return path;
+    }
+
+    return directory + "/" + path;
+}
+
+/**
+ * Escape a file name to be used in a make rule.
+ */
+xcom::String makeEscape(xcom::String const& name)
+{
+    xcom::String result;
+
+    for(xcom::String::size_type i = 0; i < name.size(); ++i)
+    {
+        if(name[i] == ' ' || name[i] == '#')
+        {
+            result += '\\';
+        }
+        else if(name[i] == '$')
+        {
+            result += '$';
+        }
+
+        result += name[i];
+    }
+
+    return result;
+}
+
+/**
+ * Write a make rule making the headers generated from the idl file
+ * depend on it and on the files it imports. An empty rule is added for
+ * each import so that make does not fail when one is removed.
+ */
+void writeDependencies(ostream& os,
+                       xcom::String const& idlFile,
+                       xcom::StringSeq const& dependencies,
+                       bool singleHeader)
+{
+    xcom::String base(baseName(idlFile));
+    
+    os << makeEscape(base + ".hpp");
+    if(!singleHeader)
+    {
+        os << ' ' << makeEscape(base + "Tie.hpp");
+    }
+    os << ": " << makeEscape(idlFile);
+
+    xcom::StringSeq::const_iterator i;
+    
+    for(i = dependencies.begin(); i != dependencies.end(); ++i)
+    {
+        os << " \\\n  " << makeEscape(*i);
+    }
+    os << "\n";
+
+    for(i = dependencies.begin(); i != dependencies.end(); ++i)
+    {
+        os << "\n" << makeEscape(*i) << ":\n";
+    }
+}
+
 bool isOption(const xcom::String& str)
 {
     return str.length() &&  str[0] == '-';
@@ -124,55 +354,587 @@ xcom::StringSeq filterOptions(xcom::StringSeq& args)
     return output;
 }
 
-int main(int argc, char* argv[])
+/**
+ * Compilation of one idl file.
+ */
+struct Job
 {
-    if(xcom::loadAsBuiltin("xcomidl_parser").isNil())
+    xcom::String file;
+    xcom::StringSeq messages;
+    xcom::StringSeq dependencies;
+    xcom::String exception; // set if the compilation is aborted
+    bool generated;
+    bool done;
+};
+
+/**
+ * Hands out the jobs in order to the workers and lets the reporting
+ * thread wait for their completion, so diagnostics are reported in
+ * the order of the files on the command line.
+ * After a job is aborted with an exception no more jobs are handed out.
+ */
+class JobQueue
+{
+public:
+    JobQueue(xcom::StringSeq const& files)
+    : jobs_(files.size()), next_(0), aborted_(false)
     {
-        cerr << "cannot load idl parser\n";
-        return -1;
+        for(size_t i = 0; i < files.size(); ++i)
+        {
+            jobs_[i].file = files[i];
+            jobs_[i].generated = false;
+            jobs_[i].done = false;
+        }
+    }
+
+    /**
+     * Next job to compile, nil if none is left.
+     */
+    Job* take()
+    {
+        lock_guard<mutex> guard(lock_);
+
+        if(aborted_ || next_ == jobs_.size())
+        {
+            return 0;
+        }
+
+        return &jobs_[next_++];
+    }
+
+    /**
+     * Mark the job as complete.
+     */
+    void finish(Job* job)
+    {
+        lock_guard<mutex> guard(lock_);
+
+        job->done = true;
+        if(job->exception.size() != 0)
+        {
+            aborted_ = true;
+        }
+        
+        finished_.notify_all();
+    }
+
+    /**
+     * Hand out no more jobs. Jobs already taken still finish.
+     */
+    void abort()
+    {
+        lock_guard<mutex> guard(lock_);
+
+        aborted_ = true;
     }
     
-    if(xcom::loadAsBuiltin("xcomidl_cppgen").isNil())
+    /**
+     * Wait until the job with the given index completes.
+     */
+    Job& wait(size_t index)
     {
-        cerr << "cannot load c++ code generator\n";
-        return -1;
+        unique_lock<mutex> guard(lock_);
+
+        while(!jobs_[index].done)
+        {
+            finished_.wait(guard);
+        }
+
+        return jobs_[index];
     }
 
-    xcom::StringSeq args(argvToStringVec(argc, argv));
+    size_t size() const
+    {
+        return jobs_.size();
+    }
     
-    try
+private:
+    vector<Job> jobs_;
+    size_t next_;
+    bool aborted_;
+    mutex lock_;
+    condition_variable finished_;
+};
+
+/**
+ * Joins the worker threads at the latest when it goes out of scope.
+ * The queue is aborted first, so however the compilation ends the
+ * workers take no more jobs and no thread is left running.
+ */
+class WorkerGuard
+{
+public:
+    WorkerGuard(JobQueue& queue, vector<thread>& workers)
+    : queue_(queue), workers_(workers)
+    {
+    }
+
+    ~WorkerGuard()
     {
-        xcom::StringSeq includes(filterIncludePaths(args));
-        xcom::StringSeq options(filterOptions(args));
+        join();
+    }
+
+    /**
+     * Stop the queue and wait for the workers started so far.
+     */
+    void join()
+    {
+        queue_.abort();
+
+        for(size_t i = 0; i < workers_.size(); ++i)
+        {
+            if(workers_[i].joinable())
+            {
+                workers_[i].join();
+            }
+        }
+    }
 
-        xcomidl::IParser parser(xcom::createObjectAs<xcomidl::IParser>("xcomidl.Parser"));
-        xcomidl::ICodeGen codegen(xcom::createObjectAs<xcomidl::ICodeGen>("xcomidl.CppGen"));
+private:
+    JobQueue& queue_;
+    vector<thread>& workers_;
 
-        for(xcom::StringSeq::const_iterator i = args.begin(); i != args.end(); ++i)
+    WorkerGuard(WorkerGuard const&);
+    WorkerGuard& operator=(WorkerGuard const&);
+};
+
+/**
+ * Parse and generate code for the jobs in the queue until it is empty.
+ * Each worker uses its own parser and code generator. The idl files
+ * are found and the headers are written relative to the directory.
+ */
+void compileJobs(JobQueue& queue,
+                 xcomidl::IParser2 parser,
+                 xcomidl::ICodeGen2 codegen,
+                 xcom::String const& directory,
+                 xcom::StringSeq const& includes,
+                 xcom::StringSeq const& options)
+{
+    Job* job;
+    
+    while((job = queue.take()) != 0)
+    {
+        try
         {
+            xcom::String file(resolvePath(directory, job->file));
             xcomidl::TypeSeq types;
             xcomidl::HintSeq hints;
-            xcom::StringSeq messages;
+
+            if(parser.parseWithDependencies(includes, file.c_str(),
+                                            types, hints, job->dependencies,
+                                            job->messages))
+            {
+                xcom::StringSeq names, contents;
+
+                codegen.generateToBuffers(types, hints, file.c_str(),
+                                          options, names, contents);
+
+                for(size_t i = 0; i < names.size(); ++i)
+                {
+                    writeOutput(resolvePath(directory, names[i]).c_str(),
+                                contents[i].c_str());
+                }
+                
+                job->generated = true;
+            }
+        }
+        catch(exception& e)
+        {
+            job->exception = e.what();
+        }
+        catch(char const* e)
+        {
+            job->exception = e;
+        }
+
+        queue.finish(job);
+    }
+}
+
+/**
+ * Parsers and code generators, one for each worker. The server keeps
+ * them between compilations so parsed imports stay in memory.
+ */
+struct Compilers
+{
+    vector<xcomidl::IParser2> parsers;
+    vector<xcomidl::ICodeGen2> codegens;
+};
+
+/**
+ * Settings given with the command line.
+ */
+struct Settings
+{
+    /**
+     * Directory the relative paths are resolved in, empty for the
+     * working directory.
+     */
+    xcom::String directory;
+    
+    DependencyOptions depOptions;
+    xcom::String moduleCache;
+    xcom::StringSeq includes;
+    int jobCount;
+    xcom::StringSeq options;
+    bool singleHeader;
+    bool watch;
+
+    /**
+     * Idl files to compile.
+     */
+    xcom::StringSeq files;
+};
+
+/**
+ * Split the command line arguments into settings, paths being relative
+ * to the given directory.
+ */
+Settings parseArguments(xcom::StringSeq args,
+                        xcom::String const& directory = xcom::String())
+{
+    Settings result;
+    xcom::StringSeq::iterator watch = find(args.begin(), args.end(), "--watch");
+
+    result.watch = watch != args.end();
+    if(result.watch)
+    {
+        args.erase(watch);
+    }
+    
+    result.directory = directory;
+    result.depOptions = filterDependencyOptions(args);
+    result.moduleCache = filterValueOption(args, "--module-cache");
+    result.includes = filterIncludePaths(args);
+
+    if(result.depOptions.file.size() != 0)
+    {
+        result.depOptions.file =
+            resolvePath(directory, result.depOptions.file);
+    }
+
+    if(result.moduleCache.size() != 0)
+    {
+        result.moduleCache = resolvePath(directory, result.moduleCache);
+    }
+
+    xcom::StringSeq::iterator include;
+
+    for(include = result.includes.begin(); include != result.includes.end();
+        ++include)
+    {
+        *include = resolvePath(directory, *include);
+    }
+
+    result.jobCount = filterJobCount(args);
+    result.options = filterOptions(args);
+    result.singleHeader =
+        find(result.options.begin(), result.options.end(), "-s") != result.options.end() ||
+        find(result.options.begin(), result.options.end(), "--single-header") != result.options.end();
+    result.files = args;
+
+    return result;
+}
+
+/**
+ * Files imported by the compiled idl files, by idl file.
+ */
+typedef map<xcom::String, xcom::StringSeq> DependencyMap;
+
+/**
+ * Compile the given idl files with the settings, writing the diagnostics
+ * to err. The imports of the files that are generated are stored in
+ * dependencies. If a dependency file is given, it is rewritten with the
+ * rules of all of the files in the settings that are in dependencies.
+ * Returns the exit status, 1 if a file could not be compiled.
+ */
+int compile(Settings const& settings, xcom::StringSeq const& files,
+            Compilers& compilers, DependencyMap& dependencies, ostream& err)
+{
+    int status = 0;
+    
+    try
+    {
+        size_t workerCount = max<size_t>(1, min<size_t>(settings.jobCount, files.size()));
+
+        // Every worker gets its own objects. They are all created
+        // before starting the workers since the loader is not known
+        // to be thread safe.
+        while(compilers.parsers.size() < workerCount)
+        {
+            compilers.parsers.push_back(xcom::createObjectAs<xcomidl::IParser2>("xcomidl.Parser"));
+            compilers.codegens.push_back(xcom::createObjectAs<xcomidl::ICodeGen2>("xcomidl.CppGen"));
+        }
+
+        for(size_t i = 0; i < workerCount; ++i)
+        {
+            compilers.parsers[i].setCacheDirectory(settings.moduleCache.c_str());
+        }
+        
+        DependencyOptions const& depOptions = settings.depOptions;
+        ofstream depFile;
+
+        if(depOptions.file.size() != 0)
+        {
+            depFile.open(depOptions.file.c_str());
+
+            if(!depFile.is_open())
+            {
+                throw runtime_error("cannot open dependency file: " +
+                                    depOptions.file);
+            }
+        }
+        
+        JobQueue queue(files);
+        vector<thread> workers;
+        WorkerGuard guard(queue, workers);
+
+        if(workerCount > 1)
+        {
+            // No reallocation may throw while a thread is unowned.
+            workers.reserve(workerCount);
+            
+            for(size_t i = 0; i < workerCount; ++i)
+            {
+                workers.push_back(thread(compileJobs, ref(queue),
+                                         compilers.parsers[i],
+                                         compilers.codegens[i],
+                                         cref(settings.directory),
+                                         cref(settings.includes),
+                                         cref(settings.options)));
+            }
+        }
+        else
+        {
+            compileJobs(queue, compilers.parsers[0], compilers.codegens[0],
+                        settings.directory, settings.includes,
+                        settings.options);
+        }
+
+        for(size_t i = 0; i < queue.size(); ++i)
+        {
+            Job& job = queue.wait(i);
             
-            if(!parser.parse(includes, (*i).c_str(), types, hints, messages))
+            copy(job.messages.begin(), job.messages.end(), std::ostream_iterator<xcom::String>(err, "\n"));
+
+            if(job.exception.size() != 0)
+            {
+                err << "exception: " << job.exception << '\n';
+                status = 1;
+                queue.abort();
+                break;
+            }
+
+            if(!job.generated)
             {
-                copy(messages.begin(), messages.end(), std::ostream_iterator<xcom::String>(cerr, "\n"));
+                status = 1;
             }
             else
             {
-                codegen.generate(types, hints, (*i).c_str(), options);
+                dependencies[job.file] = job.dependencies;
+            }
+            
+            if(depOptions.enabled && job.generated && !depFile.is_open())
+            {
+                ofstream os(resolvePath(settings.directory,
+                                        baseName(job.file) + ".d").c_str());
+                writeDependencies(os, job.file, job.dependencies,
+                                  settings.singleHeader);
             }
+        }
+
+        guard.join();
 
-            messages.clear();
+        xcom::StringSeq::const_iterator file;
+        
+        for(file = settings.files.begin(); depFile.is_open() && file != settings.files.end(); ++file)
+        {
+            DependencyMap::const_iterator deps = dependencies.find(*file);
+
+            if(deps != dependencies.end())
+            {
+                writeDependencies(depFile, *file, deps->second,
+                                  settings.singleHeader);
+            }
         }
     }
     catch(exception& e)
     {
-        cerr << "exception: " << e.what() << '\n';
+        err << "exception: " << e.what() << '\n';
+        status = 1;
     }
     catch(char const* e)
     {
-        cerr << "exception: "<< e << '\n';
+        err << "exception: "<< e << '\n';
+        status = 1;
+    }
+    
+    return status;
+}
+
+/**
+ * Compile the idl files with the given command line arguments, paths
+ * being relative to the given directory.
+ */
+int compile(xcom::String const& directory, xcom::StringSeq const& args,
+            Compilers& compilers, ostream& err)
+{
+    Settings settings;
+    DependencyMap dependencies;
+    
+    try
+    {
+        settings = parseArguments(args, directory);
+    }
+    catch(exception& e)
+    {
+        err << "exception: " << e.what() << '\n';
+        return 1;
+    }
+    
+    return compile(settings, settings.files, compilers, dependencies, err);
+}
+
+/**
+ * Compile the idl files, then recompile the files that change or
+ * import a file that changes, until the process is killed.
+ */
+int watch(Settings const& settings, Compilers& compilers)
+{
+    DependencyMap dependencies;
+    FileWatcher watcher;
+    map<xcom::String, string> paths;
+    xcom::StringSeq::const_iterator file;
+
+    for(file = settings.files.begin(); file != settings.files.end(); ++file)
+    {
+        paths[*file] = FileWatcher::canonicalPath(file->c_str());
+        watcher.watch(paths[*file]);
+    }
+
+    // The imports are known only after a compile has read them, so they
+    // are checked for changes made since it started.
+    time_t started = time(0);
+    
+    compile(settings, settings.files, compilers, dependencies, cerr);
+
+    for(;;)
+    {
+        for(file = settings.files.begin(); file != settings.files.end(); ++file)
+        {
+            xcom::StringSeq const& deps = dependencies[*file];
+            xcom::StringSeq::const_iterator dep;
+
+            for(dep = deps.begin(); dep != deps.end(); ++dep)
+            {
+                watcher.watch(dep->c_str(), started);
+            }
+        }
+
+        set<string> changed(watcher.wait());
+        xcom::StringSeq files;
+
+        for(file = settings.files.begin(); file != settings.files.end(); ++file)
+        {
+            bool affected = changed.count(paths[*file]) != 0;
+            xcom::StringSeq const& deps = dependencies[*file];
+            xcom::StringSeq::const_iterator dep;
+
+            for(dep = deps.begin(); !affected && dep != deps.end(); ++dep)
+            {
+                affected = changed.count(dep->c_str()) != 0;
+            }
+
+            if(affected)
+            {
+                files.push_back(*file);
+            }
+        }
+
+        if(files.size() != 0)
+        {
+            cerr << "recompiling " << files.size() << " file(s)\n";
+            started = time(0);
+            compile(settings, files, compilers, dependencies, cerr);
+        }
+    }
+}
+
+/**
+ * Compiles the requests of the server with the same compilers.
+ */
+class CompileHandler : public RequestHandler
+{
+public:
+    int handle(std::string const& directory, xcom::StringSeq const& args,
+               ostream& err)
+    {
+        return compile(directory.c_str(), args, compilers_, err);
+    }
+
+private:
+    Compilers compilers_;
+};
+
+int main(int argc, char* argv[])
+{
+    xcom::StringSeq args(argvToStringVec(argc, argv));
+    xcom::String serverSocket;
+    
+    try
+    {
+        xcom::String clientSocket(filterValueOption(args, "--client"));
+        int status;
+        
+        // Without a running server the client compiles by itself.
+        if(clientSocket.size() != 0 &&
+           runClient(clientSocket.c_str(), args, cerr, status))
+        {
+            return status;
+        }
+
+        serverSocket = filterValueOption(args, "--server");
+    }
+    catch(exception& e)
+    {
+        cerr << "exception: " << e.what() << '\n';
+        return -1;
+    }
+    
+    if(xcom::loadAsBuiltin("xcomidl_parser").isNil())
+    {
+        cerr << "cannot load idl parser\n";
+        return -1;
+    }
+    
+    if(xcom::loadAsBuiltin("xcomidl_cppgen").isNil())
+    {
+        cerr << "cannot load c++ code generator\n";
+        return -1;
+    }
+
+    if(serverSocket.size() == 0 &&
+       find(args.begin(), args.end(), "--watch") == args.end())
+    {
+        Compilers compilers;
+        return compile(xcom::String(), args, compilers, cerr);
+    }
+    
+    try
+    {
+        if(serverSocket.size() == 0)
+        {
+            Compilers compilers;
+            return watch(parseArguments(args), compilers);
+        }
+        
+        CompileHandler handler;
+        runServer(serverSocket.c_str(), handler);
+    }
+    catch(exception& e)
+    {
+        cerr << "exception: " << e.what() << '\n';
+        return -1;
     }
     
     return 0;
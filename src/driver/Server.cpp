@@ -0,0 +1,409 @@
+/**
+ * File    : Server.cpp
+ * Author  : Emir Uner
+ * Summary : Resident compile server and its client.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Server.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <signal.h>
+#include <limits.h>
+#include <string.h>
+#include <errno.h>
+#endif
+
+/**
+ * Requests and responses are sequences of 32 bit unsigned integers and
+ * strings in the byte order of the host, strings being prefixed with
+ * their length.
+ * A request is the number of strings that follow, the working directory
+ * of the client and the command line arguments. The response is the
+ * exit status and the diagnostics.
+ * Lengths and counts are checked against the limits below before
+ * anything is allocated for them, so a damaged or hostile request
+ * cannot exhaust the memory of the server.
+ */
+
+#ifndef _WIN32
+
+namespace
+{
+
+/**
+ * Most strings in a request, the working directory included.
+ */
+unsigned int const MAX_REQUEST_STRINGS = 4096;
+
+/**
+ * Most characters of all strings in a request together.
+ */
+unsigned int const MAX_REQUEST_SIZE = 1024 * 1024;
+
+/**
+ * Most characters of the diagnostics in a response.
+ */
+unsigned int const MAX_RESPONSE_SIZE = 64 * 1024 * 1024;
+
+/**
+ * Seconds the server waits for a client to send or receive data.
+ */
+int const CLIENT_TIMEOUT = 10;
+
+bool writeAll(int fd, char const* data, size_t size)
+{
+    while(size > 0)
+    {
+        ssize_t written = write(fd, data, size);
+
+        if(written < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        data += written;
+        size -= written;
+    }
+
+    return true;
+}
+
+bool readAll(int fd, char* data, size_t size)
+{
+    while(size > 0)
+    {
+        ssize_t got = read(fd, data, size);
+
+        if(got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if(got <= 0)
+        {
+            return false;
+        }
+
+        data += got;
+        size -= got;
+    }
+
+    return true;
+}
+
+bool writeInt(int fd, unsigned int value)
+{
+    return writeAll(fd, (char const*)&value, sizeof(value));
+}
+
+bool readInt(int fd, unsigned int& value)
+{
+    return readAll(fd, (char*)&value, sizeof(value));
+}
+
+bool writeString(int fd, std::string const& str)
+{
+    return writeInt(fd, (unsigned int)str.size()) &&
+        writeAll(fd, str.data(), str.size());
+}
+
+/**
+ * Read a string of at most limit characters and subtract its length
+ * from limit. Returns false if the string is longer.
+ */
+bool readString(int fd, std::string& str, unsigned int& limit)
+{
+    unsigned int size;
+
+    if(!readInt(fd, size) || size > limit)
+    {
+        return false;
+    }
+
+    limit -= size;
+
+    str.resize(size);
+
+    return size == 0 || readAll(fd, &str[0], size);
+}
+
+/**
+ * Fill the socket address for the path.
+ * Throws runtime_error if the path is too long.
+ */
+void makeAddress(std::string const& path, sockaddr_un& address)
+{
+    if(path.size() >= sizeof(address.sun_path))
+    {
+        throw std::runtime_error("socket path is too long: " + path);
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path.c_str());
+}
+
+/**
+ * Return true if the peer of the connection runs as the same user as
+ * this process.
+ */
+bool sameUser(int fd)
+{
+#ifdef SO_PEERCRED
+    struct ucred cred;
+    socklen_t length = sizeof(cred);
+
+    return getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &length) == 0 &&
+        cred.uid == getuid();
+#else
+    uid_t uid;
+    gid_t gid;
+
+    return getpeereid(fd, &uid, &gid) == 0 && uid == getuid();
+#endif
+}
+
+/**
+ * Limit the time a read or write on the connection may block.
+ */
+bool setTimeouts(int fd)
+{
+    struct timeval timeout;
+
+    timeout.tv_sec = CLIENT_TIMEOUT;
+    timeout.tv_usec = 0;
+
+    return setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout,
+                      sizeof(timeout)) == 0 &&
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout,
+                   sizeof(timeout)) == 0;
+}
+    
+/**
+ * Read a request from the connection, compile it relative to the
+ * working directory of the client and send the response.
+ */
+void serveConnection(int fd, RequestHandler& handler)
+{
+    if(!sameUser(fd) || !setTimeouts(fd))
+    {
+        return;
+    }
+    
+    unsigned int count;
+    unsigned int limit = MAX_REQUEST_SIZE;
+    std::string directory;
+
+    if(!readInt(fd, count) || count == 0 || count > MAX_REQUEST_STRINGS ||
+       !readString(fd, directory, limit))
+    {
+        return;
+    }
+
+    xcom::StringSeq args;
+
+    for(unsigned int i = 1; i < count; ++i)
+    {
+        std::string arg;
+
+        if(!readString(fd, arg, limit))
+        {
+            return;
+        }
+
+        args.push_back(arg.c_str());
+    }
+
+    std::ostringstream err;
+    int status;
+    
+    if(directory.empty() || directory[0] != '/')
+    {
+        err << "not an absolute directory: " << directory << '\n';
+        status = 1;
+    }
+    else
+    {
+        status = handler.handle(directory, args, err);
+    }
+
+    // The client may be gone, there is nobody to report to then.
+    writeInt(fd, (unsigned int)status) && writeString(fd, err.str());
+}
+    
+} // namespace <unnamed>
+
+void runServer(std::string const& socketPath, RequestHandler& handler)
+{
+    sockaddr_un address;
+
+    makeAddress(socketPath, address);
+
+    // Writing to a client that went away must not end the server.
+    signal(SIGPIPE, SIG_IGN);
+    
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if(listener < 0)
+    {
+        throw std::runtime_error("cannot create socket");
+    }
+
+    struct stat st;
+
+    // Only a socket left by an earlier server is replaced.
+    if(lstat(socketPath.c_str(), &st) == 0)
+    {
+        if(!S_ISSOCK(st.st_mode))
+        {
+            close(listener);
+            throw std::runtime_error("not a socket: " + socketPath);
+        }
+
+        unlink(socketPath.c_str());
+    }
+    
+    // Nobody can connect before listen, so the mode is set in time.
+    if(bind(listener, (sockaddr*)&address, sizeof(address)) != 0 ||
+       chmod(socketPath.c_str(), S_IRUSR | S_IWUSR) != 0 ||
+       listen(listener, 16) != 0)
+    {
+        close(listener);
+        throw std::runtime_error("cannot listen on socket: " + socketPath);
+    }
+
+    for(;;)
+    {
+        int fd = accept(listener, 0, 0);
+
+        if(fd < 0)
+        {
+            if(errno == EINTR || errno == ECONNABORTED)
+            {
+                continue;
+            }
+
+            close(listener);
+            throw std::runtime_error("cannot accept on socket: " + socketPath);
+        }
+
+        // A failed request must not end the server.
+        try
+        {
+            serveConnection(fd, handler);
+        }
+        catch(std::exception& e)
+        {
+            std::cerr << "request failed: " << e.what() << '\n';
+        }
+        catch(...)
+        {
+            std::cerr << "request failed\n";
+        }
+        
+        close(fd);
+    }
+}
+
+bool runClient(std::string const& socketPath, xcom::StringSeq const& args,
+               std::ostream& err, int& status)
+{
+    sockaddr_un address;
+    char directory[PATH_MAX];
+
+    makeAddress(socketPath, address);
+
+    if(getcwd(directory, sizeof(directory)) == 0)
+    {
+        return false;
+    }
+    
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if(fd < 0)
+    {
+        return false;
+    }
+
+    if(connect(fd, (sockaddr*)&address, sizeof(address)) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    bool sent = writeInt(fd, (unsigned int)args.size() + 1) &&
+        writeString(fd, directory);
+    xcom::StringSeq::const_iterator i;
+
+    for(i = args.begin(); sent && i != args.end(); ++i)
+    {
+        sent = writeString(fd, i->c_str());
+    }
+    
+    unsigned int result;
+    unsigned int limit = MAX_RESPONSE_SIZE;
+    std::string messages;
+
+    if(!sent || !readInt(fd, result) || !readString(fd, messages, limit))
+    {
+        close(fd);
+        throw std::runtime_error("connection to server lost: " + socketPath);
+    }
+
+    close(fd);
+
+    err << messages;
+    status = (int)result;
+
+    return true;
+}
+
+#else
+
+void runServer(std::string const&, RequestHandler&)
+{
+    throw std::runtime_error("--server is not supported on this platform");
+}
+
+bool runClient(std::string const&, xcom::StringSeq const&, std::ostream&,
+               int&)
+{
+    return false;
+}
+
+#endif
@@ -0,0 +1,76 @@
+/**
+ * File    : Server.hpp
+ * Author  : Emir Uner
+ * Summary : Resident compile server and its client.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_DRIVER_SERVER_HPP_INCLUDED
+#define XCOMIDL_DRIVER_SERVER_HPP_INCLUDED
+
+#include <xcom/Types.hpp>
+
+#include <ostream>
+#include <string>
+
+/**
+ * Compiles the requests received by the server.
+ */
+class RequestHandler
+{
+public:
+    virtual ~RequestHandler()
+    {
+    }
+
+    /**
+     * Compile with the given command line arguments, writing the
+     * diagnostics to err. Returns the exit status of the compilation.
+     * Relative paths are resolved against directory, the absolute
+     * working directory of the client.
+     */
+    virtual int handle(std::string const& directory,
+                       xcom::StringSeq const& args, std::ostream& err) = 0;
+};
+
+/**
+ * Serve compile requests on the unix domain socket at the given path
+ * until the process is killed. Requests are handled one at a time, a
+ * client that stalls for longer than a timeout is dropped. Only the
+ * user running the server may connect, the socket is accessible to
+ * that user only and requests from other users are refused.
+ * An existing socket at the path is replaced.
+ * Throws runtime_error if the socket cannot be created or another kind
+ * of file exists at the path.
+ */
+void runServer(std::string const& socketPath, RequestHandler& handler);
+
+/**
+ * Send the arguments and the working directory to the server listening
+ * at the given path and write the diagnostics it returns to err.
+ * Returns false if no server accepts the connection, otherwise the exit
+ * status of the compilation is stored in status.
+ */
+bool runClient(std::string const& socketPath, xcom::StringSeq const& args,
+               std::ostream& err, int& status);
+
+#endif
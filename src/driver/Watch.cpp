@@ -0,0 +1,267 @@
+/**
+ * File    : Watch.cpp
+ * Author  : Emir Uner
+ * Summary : Change notification for the watched idl files.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Watch.hpp"
+
+#include <xcomidl/Hash.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <stdlib.h>
+#include <limits.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+namespace
+{
+
+/**
+ * Hash of the contents of the file, zero if it cannot be read.
+ */
+unsigned long long fileHash(std::string const& path)
+{
+    std::ifstream is(path.c_str(), std::ios::binary);
+
+    if(!is.is_open())
+    {
+        return 0;
+    }
+    
+    std::ostringstream buffer;
+    buffer << is.rdbuf();
+
+    std::string const& content = buffer.str();
+
+    return xcomidl::contentHash(content.data(),
+                                content.data() + content.size());
+}
+
+/**
+ * Whether the file was modified at or after the given time.
+ */
+bool modifiedSince(std::string const& path, time_t since)
+{
+    struct stat st;
+
+    return stat(path.c_str(), &st) == 0 && st.st_mtime >= since;
+}
+
+/**
+ * Directory part of the path.
+ */
+std::string directoryOf(std::string const& path)
+{
+    std::string::size_type slash = path.rfind('/');
+
+    if(slash == std::string::npos)
+    {
+        return ".";
+    }
+
+    return slash == 0 ? "/" : path.substr(0, slash);
+}
+
+/**
+ * Time to wait for more events after the first, so that an editor
+ * writing several files or a file in several steps causes one change.
+ */
+const int SETTLE_MILLISECONDS = 100;
+    
+} // namespace <unnamed>
+
+std::string FileWatcher::canonicalPath(std::string const& file)
+{
+#ifdef __linux__
+    char buf[PATH_MAX + 1];
+
+    if(realpath(file.c_str(), buf) != 0)
+    {
+        return buf;
+    }
+#endif
+    
+    return file;
+}
+
+#ifdef __linux__
+
+FileWatcher::FileWatcher()
+: fd_(inotify_init())
+{
+    if(fd_ < 0)
+    {
+        throw std::runtime_error("cannot initialize inotify");
+    }
+}
+
+FileWatcher::~FileWatcher()
+{
+    close(fd_);
+}
+
+void FileWatcher::watch(std::string const& path, time_t since)
+{
+    if(hashes_.find(path) != hashes_.end())
+    {
+        return;
+    }
+
+    hashes_[path] = fileHash(path);
+
+    if(since != 0 && modifiedSince(path, since))
+    {
+        pending_.insert(path);
+    }
+
+    std::string directory(directoryOf(path));
+
+    if(descriptors_.find(directory) != descriptors_.end())
+    {
+        return;
+    }
+    
+    int wd = inotify_add_watch(fd_, directory.c_str(),
+                               IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE |
+                               IN_DELETE);
+
+    if(wd < 0)
+    {
+        throw std::runtime_error("cannot watch directory: " + directory);
+    }
+
+    directories_[wd] = directory;
+    descriptors_[directory] = wd;
+}
+
+void FileWatcher::readEvents(std::set<std::string>& touched)
+{
+    char buf[16384];
+    ssize_t size = read(fd_, buf, sizeof(buf));
+
+    if(size < 0)
+    {
+        if(errno == EINTR)
+        {
+            return;
+        }
+        
+        throw std::runtime_error("cannot read inotify events");
+    }
+
+    ssize_t offset = 0;
+
+    while(offset < size)
+    {
+        inotify_event const* event = (inotify_event const*)(buf + offset);
+        std::map<int, std::string>::const_iterator directory =
+            directories_.find(event->wd);
+
+        if(directory != directories_.end() && event->len != 0)
+        {
+            std::string path(directory->second + '/' + event->name);
+
+            if(hashes_.find(path) != hashes_.end())
+            {
+                touched.insert(path);
+            }
+        }
+
+        offset += sizeof(inotify_event) + event->len;
+    }
+}
+
+std::set<std::string> FileWatcher::wait()
+{
+    std::set<std::string> changed;
+
+    changed.swap(pending_);
+    
+    while(changed.empty())
+    {
+        std::set<std::string> touched;
+        pollfd pfd;
+
+        pfd.fd = fd_;
+        pfd.events = POLLIN;
+        
+        readEvents(touched);
+
+        while(poll(&pfd, 1, SETTLE_MILLISECONDS) > 0)
+        {
+            readEvents(touched);
+        }
+
+        std::set<std::string>::const_iterator i;
+        
+        for(i = touched.begin(); i != touched.end(); ++i)
+        {
+            unsigned long long hash = fileHash(*i);
+
+            if(hash != hashes_[*i])
+            {
+                hashes_[*i] = hash;
+                changed.insert(*i);
+            }
+        }
+    }
+
+    return changed;
+}
+
+#else
+
+FileWatcher::FileWatcher()
+: fd_(-1)
+{
+    throw std::runtime_error("--watch is not supported on this platform");
+}
+
+FileWatcher::~FileWatcher()
+{
+}
+
+void FileWatcher::watch(std::string const&, time_t)
+{
+}
+
+void FileWatcher::readEvents(std::set<std::string>&)
+{
+}
+
+std::set<std::string> FileWatcher::wait()
+{
+    return std::set<std::string>();
+}
+
+#endif
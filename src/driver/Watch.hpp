@@ -0,0 +1,106 @@
+/**
+ * File    : Watch.hpp
+ * Author  : Emir Uner
+ * Summary : Change notification for the watched idl files.
+ */
+
+/**
+ * This file is part of XCOM.
+ *
+ * Copyright (C) 2003 Emir Uner
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef XCOMIDL_DRIVER_WATCH_HPP_INCLUDED
+#define XCOMIDL_DRIVER_WATCH_HPP_INCLUDED
+
+#include <map>
+#include <set>
+#include <string>
+
+#include <time.h>
+
+/**
+ * Reports the files whose contents change. The directories of the
+ * files are watched rather than the files, since editors often save by
+ * replacing the file.
+ * A file is reported only if its contents differ from when it was last
+ * seen, so saving a file without modifying it is not a change.
+ */
+class FileWatcher
+{
+public:
+    /**
+     * Throws runtime_error if watching is not supported.
+     */
+    FileWatcher();
+
+    ~FileWatcher();
+
+    /**
+     * Canonical path of the file, the file itself if it cannot be
+     * resolved.
+     */
+    static std::string canonicalPath(std::string const& file);
+    
+    /**
+     * Watch the file with the given canonical path. Its contents are
+     * hashed now, so the file should be watched before it is read.
+     * A file that is only known after it was read is watched with the
+     * time reading started, and is reported as changed by the next wait
+     * if it was modified since then.
+     */
+    void watch(std::string const& path, time_t since = 0);
+    
+    /**
+     * Wait until some of the watched files change and return their
+     * paths. Changes that follow closely are collected together.
+     */
+    std::set<std::string> wait();
+    
+private:
+    int fd_;
+
+    /**
+     * Watched directories by watch descriptor.
+     */
+    std::map<int, std::string> directories_;
+
+    /**
+     * Watch descriptors by directory.
+     */
+    std::map<std::string, int> descriptors_;
+    
+    /**
+     * Content hashes of the watched files.
+     */
+    std::map<std::string, unsigned long long> hashes_;
+
+    /**
+     * Files that may have changed before they were watched.
+     */
+    std::set<std::string> pending_;
+
+    FileWatcher(FileWatcher const&);
+    FileWatcher& operator=(FileWatcher const&);
+    
+    /**
+     * Read the pending events and add the watched files they name.
+     */
+    void readEvents(std::set<std::string>& touched);
+};
+
+#endif